@@ -2,10 +2,21 @@
 #include "output.hpp"
 #include <stdexcept>
 #include <string>
+#include <cstddef>
 
-using std::list;
+using std::size_t;
 
-syntax_base::syntax_base(): children(), parent(nullptr)
+syntax_base::syntax_base(syntax_kind node_kind): parent(nullptr), first_child(nullptr), last_child(nullptr), next_sibling(nullptr), node_kind(node_kind)
+{
+}
+
+void* syntax_base::operator new(size_t size, syntax_arena& arena)
+{
+    return arena.allocate(size, alignof(std::max_align_t));
+}
+
+// called only when a constructor throws, the memory is released with the rest of the arena.
+void syntax_base::operator delete(void*, syntax_arena&)
 {
 }
 
@@ -14,6 +25,16 @@ const syntax_base* syntax_base::get_parent() const
     return parent;
 }
 
+const syntax_base* syntax_base::get_first_child() const
+{
+    return first_child;
+}
+
+const syntax_base* syntax_base::get_next_sibling() const
+{
+    return next_sibling;
+}
+
 void syntax_base::push_back_child(syntax_base* child)
 {
     if (child == nullptr)
@@ -21,7 +42,16 @@ void syntax_base::push_back_child(syntax_base* child)
         return;
     }
 
-    children.push_back(child);
+    if (last_child == nullptr)
+    {
+        first_child = child;
+    }
+    else
+    {
+        last_child->next_sibling = child;
+    }
+
+    last_child = child;
     child->parent = this;
 }
 
@@ -32,18 +62,47 @@ void syntax_base::push_front_child(syntax_base* child)
         return;
     }
 
-    children.push_front(child);
+    if (first_child == nullptr)
+    {
+        last_child = child;
+    }
+
+    child->next_sibling = first_child;
+    first_child = child;
     child->parent = this;
 }
 
-const list<syntax_base*>& syntax_base::get_children() const
+syntax_range<syntax_base> syntax_base::get_children() const
+{
+    return syntax_range<syntax_base>(first_child);
+}
+
+expression_syntax::expression_syntax(syntax_kind node_kind, type_kind return_type): syntax_base(node_kind), poisoned(false), return_type(return_type)
+{
+
+}
+
+bool expression_syntax::inherit_poison(std::initializer_list<const expression_syntax*> operands)
 {
-    return children;
+    for (const expression_syntax* operand : operands)
+    {
+        if (operand->is_poisoned())
+        {
+            poisoned = true;
+        }
+    }
+
+    return poisoned;
 }
 
-expression_syntax::expression_syntax(type_kind return_type): return_type(return_type)
+bool expression_syntax::is_poisoned() const
 {
+    return poisoned;
+}
 
+void expression_syntax::poison()
+{
+    poisoned = true;
 }
 
 bool expression_syntax::is_numeric() const
@@ -56,6 +115,6 @@ bool expression_syntax::is_special() const
     return types::is_special(return_type);
 }
 
-statement_syntax::statement_syntax()
+statement_syntax::statement_syntax(syntax_kind node_kind): syntax_base(node_kind)
 {
 }
@@ -2,31 +2,53 @@
 #define _ABSTRACT_SYNTAX_HPP_
 
 #include "syntax_token.hpp"
+#include "syntax_arena.hpp"
 #include "types.hpp"
 #include <vector>
 #include <string>
-#include <list>
+#include <initializer_list>
+#include <cstdint>
 
+// the concrete class of a node, so a pass over the tree can switch on it.
+enum class syntax_kind: std::uint8_t
+{
+    Root, Function, Parameter, Type, List,
+    If, While, Branch, Return, ExpressionStatement, Assignment, Declaration, Block,
+    Literal, Cast, Not, Logical, Arithmetic, Relational, Conditional, Identifier, Invocation
+};
+
+template<typename node_type> class syntax_range;
+
+// nodes are allocated from the arena of the check with new (arena) type(...), and are never deleted.
+// the arena releases a whole tree at once, so a node keeps nothing that would need its destructor to run.
+// the children of a node are linked through their own next_sibling, a node has a single parent.
 class syntax_base
 {
     private:
 
-    std::list<syntax_base*> children;
-    syntax_base* parent = nullptr;
+    syntax_base* parent;
+    syntax_base* first_child;
+    syntax_base* last_child;
+    syntax_base* next_sibling;
 
     protected:
 
-    syntax_base();
+    syntax_base(syntax_kind node_kind);
 
     public:
 
+    const syntax_kind node_kind;
+
     syntax_base(const syntax_base& other) = delete;
     syntax_base& operator=(const syntax_base& other) = delete;
 
     const syntax_base* get_parent() const;
-    const std::list<syntax_base*>& get_children() const;
+    const syntax_base* get_first_child() const;
+    const syntax_base* get_next_sibling() const;
+    syntax_range<syntax_base> get_children() const;
 
-    virtual ~syntax_base() = default;
+    static void* operator new(std::size_t size, syntax_arena& arena);
+    static void operator delete(void* node, syntax_arena& arena);
 
     protected:
 
@@ -34,15 +56,80 @@ class syntax_base
     void push_front_child(syntax_base* child);
 };
 
+// the nodes from first along their next_sibling links, viewed as node_type.
+template<typename node_type> class syntax_range
+{
+    private:
+
+    const syntax_base* first;
+
+    public:
+
+    class iterator
+    {
+        private:
+
+        const syntax_base* node;
+
+        public:
+
+        iterator(const syntax_base* node): node(node)
+        {
+        }
+
+        const node_type* operator*() const
+        {
+            return static_cast<const node_type*>(node);
+        }
+
+        iterator& operator++()
+        {
+            node = node->get_next_sibling();
+            return *this;
+        }
+
+        bool operator==(const iterator& other) const
+        {
+            return node == other.node;
+        }
+
+        bool operator!=(const iterator& other) const
+        {
+            return node != other.node;
+        }
+    };
+
+    syntax_range(const syntax_base* first): first(first)
+    {
+    }
+
+    iterator begin() const
+    {
+        return iterator(first);
+    }
+
+    iterator end() const
+    {
+        return iterator(nullptr);
+    }
+};
+
 class expression_syntax: public syntax_base
 {
+    private:
+
+    bool poisoned;
+
     public:
 
     const type_kind return_type;
 
     protected:
 
-    expression_syntax(type_kind return_type);
+    expression_syntax(syntax_kind node_kind, type_kind return_type);
+
+    // poisons this expression if one of the operands is poisoned, and returns whether it did.
+    bool inherit_poison(std::initializer_list<const expression_syntax*> operands);
 
     public:
 
@@ -52,19 +139,20 @@ class expression_syntax: public syntax_base
     bool is_numeric() const;
     bool is_special() const;
 
-    virtual ~expression_syntax() = default;
+    // an expression is poisoned once an error was reported for it or for one of its operands.
+    // checks involving a poisoned expression are skipped, so one error does not cascade.
+    bool is_poisoned() const;
+    void poison();
 };
 
 class statement_syntax: public syntax_base
 {
     protected:
 
-    statement_syntax();
+    statement_syntax(syntax_kind node_kind);
 
     public:
 
-    virtual ~statement_syntax() = default;
-
     statement_syntax(const statement_syntax& other) = delete;
     statement_syntax& operator=(const statement_syntax& other) = delete;
 };
@@ -0,0 +1,86 @@
+#include "batch_checker.hpp"
+#include "check_modes.hpp"
+#include <iostream>
+#include <sstream>
+#include <filesystem>
+#include <algorithm>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <cstdint>
+
+using std::vector;
+
+batch_checker::batch_checker(std::size_t thread_count): pool(thread_count)
+{
+}
+
+int batch_checker::check(const vector<const char*>& paths, const check_options& options)
+{
+    struct batch_result
+    {
+        std::ostringstream out;
+        std::ostringstream err;
+        int res = 0;
+        bool done = false;
+    };
+
+    vector<batch_result> results(paths.size());
+    vector<std::uintmax_t> sizes(paths.size());
+    vector<std::size_t> order(paths.size());
+
+    for (std::size_t i = 0; i < paths.size(); i++)
+    {
+        std::error_code ignored;
+        std::uintmax_t size = std::filesystem::file_size(paths[i], ignored);
+
+        sizes[i] = ignored ? 0 : size;
+        order[i] = i;
+    }
+
+    // largest first, so a big file picked up last does not hold the batch back.
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return sizes[a] > sizes[b]; });
+
+    std::mutex lock;
+    std::condition_variable finished;
+
+    // results are written out in input order as soon as every earlier one is done.
+    std::thread writer([&]()
+    {
+        for (batch_result& result : results)
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            finished.wait(guard, [&]() { return result.done; });
+            guard.unlock();
+
+            std::cout << result.out.str();
+            std::cerr << result.err.str();
+
+            result.out = std::ostringstream();
+            result.err = std::ostringstream();
+        }
+
+        std::cout.flush();
+    });
+
+    pool.run(order, [&](std::size_t, std::size_t i)
+    {
+        int res = check_program(paths[i], options, results[i].out, results[i].err);
+
+        std::lock_guard<std::mutex> guard(lock);
+        results[i].res = res;
+        results[i].done = true;
+        finished.notify_all();
+    });
+
+    writer.join();
+
+    int res = 0;
+
+    for (const batch_result& result : results)
+    {
+        res = result.res != 0 ? result.res : res;
+    }
+
+    return res;
+}
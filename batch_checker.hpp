@@ -0,0 +1,29 @@
+#ifndef _BATCH_CHECKER_HPP_
+#define _BATCH_CHECKER_HPP_
+
+#include "checker_context.hpp"
+#include "work_pool.hpp"
+#include <vector>
+#include <cstddef>
+
+// checks many files in one process, each on its own as check_program checks it, on a work_pool.
+// the largest files are started first, and what each prints is written in the order the files are given, as soon as every earlier one is done.
+class batch_checker
+{
+    private:
+
+    work_pool pool;
+
+    public:
+
+    // a thread count of 0 sizes the pool to the machine.
+    batch_checker(std::size_t thread_count = 0);
+
+    batch_checker(const batch_checker& other) = delete;
+    batch_checker& operator=(const batch_checker& other) = delete;
+
+    // checks paths, writing to standard output and error. returns the last non-zero status of a file, 0 when every file checked.
+    int check(const std::vector<const char*>& paths, const check_options& options);
+};
+
+#endif
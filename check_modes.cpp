@@ -0,0 +1,226 @@
+#include "check_modes.hpp"
+#include "parser.tab.hpp"
+#include "output.hpp"
+#include "source_buffer.hpp"
+#include "stream_checker.hpp"
+#include "incremental_checker.hpp"
+#include "parallel_checker.hpp"
+#include "check_server.hpp"
+#include "load_generator.hpp"
+#include "flat_syntax.hpp"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <memory>
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+// bytes read from a pipe at a time in --stream mode.
+constexpr std::size_t stream_chunk_size = 64 * 1024;
+
+int check_program(const char* path, const check_options& options, std::ostream& out, std::ostream& err)
+{
+    output::set_stream(out);
+    output::set_max_errors(options.max_errors);
+
+    std::unique_ptr<source_buffer> source;
+    std::unique_ptr<checker_context> context;
+
+    try
+    {
+        source.reset(path != nullptr ? new source_buffer(path) : new source_buffer());
+        context.reset(new checker_context(*source, options.lexer));
+        context->keep_functions = options.check_only == false;
+    }
+    catch (const std::exception& error)
+    {
+        err << error.what() << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        context->open_global_scope();
+
+        // a parse only fails when error recovery gave up, after the syntax error was reported.
+        if (parse_program(*context) == 0)
+        {
+            context->close_global_scope();
+        }
+
+        if (options.syntax_stats && context->root != nullptr)
+        {
+            flat_syntax flat(*context->root);
+            err << "syntax: " << flat.size() << " nodes, " << context->nodes.used() << " bytes linked, " << flat.bytes() << " bytes flat" << std::endl;
+        }
+
+        if (options.lookup_stats)
+        {
+            err << "names: " << context->identifier_count << " identifiers, " << context->symtab.lookup_count() << " lookups" << std::endl;
+        }
+
+        return 0;
+    }
+    catch (const output::check_aborted&)
+    {
+        return 0;
+    }
+    catch (const std::exception& error)
+    {
+        // what was printed before stays, and a batch goes on with its other files.
+        err << error.what() << std::endl;
+        return 1;
+    }
+}
+
+int check_stream(const char* path, const check_options& options)
+{
+    int fd = path != nullptr ? open(path, O_RDONLY) : STDIN_FILENO;
+
+    if (fd < 0)
+    {
+        std::cerr << path << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+
+    stream_checker checker(options, std::cout);
+    std::unique_ptr<char[]> chunk(new char[stream_chunk_size]);
+
+    while (true)
+    {
+        ssize_t count = read(fd, chunk.get(), stream_chunk_size);
+
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (count <= 0 || checker.feed(chunk.get(), static_cast<std::size_t>(count)) == false)
+        {
+            break;
+        }
+    }
+
+    checker.finish();
+
+    if (fd != STDIN_FILENO)
+    {
+        close(fd);
+    }
+
+    if (checker.get_failure().empty() == false)
+    {
+        std::cerr << checker.get_failure() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+int check_cached(const char* path, const char* cache_path, const check_options& options)
+{
+    // with recovery a syntax error may span functions, so only a check that stops at the first diagnostic reuses results.
+    if (options.max_errors != 1)
+    {
+        return check_program(path, options, std::cout, std::cerr);
+    }
+
+    std::unique_ptr<source_buffer> source;
+
+    try
+    {
+        source.reset(path != nullptr ? new source_buffer(path) : new source_buffer());
+    }
+    catch (const std::exception& error)
+    {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+
+    incremental_checker checker;
+
+    checker.load(cache_path);
+
+    try
+    {
+        checker.check(*source, std::cout);
+    }
+    catch (const std::exception& error)
+    {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+
+    if (checker.save(cache_path) == false)
+    {
+        std::cerr << "cannot write cache " << cache_path << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+int check_parallel(const char* path, const check_options& options, std::size_t workers)
+{
+    std::unique_ptr<source_buffer> source;
+
+    try
+    {
+        source.reset(path != nullptr ? new source_buffer(path) : new source_buffer());
+    }
+    catch (const std::exception& error)
+    {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+
+    parallel_checker checker(workers);
+
+    try
+    {
+        checker.check(*source, options, std::cout);
+    }
+    catch (const std::exception& error)
+    {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+int serve(const char* socket_path, const check_options& options, std::size_t workers, std::size_t queue_limit)
+{
+    try
+    {
+        check_server server(socket_path, options, workers, queue_limit);
+        server.run();
+    }
+    catch (const std::exception& error)
+    {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+int generate_load(const char* socket_path, const char* path, std::size_t clients, std::size_t requests)
+{
+    std::ifstream file(path != nullptr ? path : "/dev/stdin", std::ios::binary);
+    std::ostringstream program;
+
+    if (file.is_open() == false)
+    {
+        std::cerr << "cannot open " << path << std::endl;
+        return 1;
+    }
+
+    program << file.rdbuf();
+
+    load_generator generator(socket_path, program.str(), clients, requests);
+    return generator.run(std::cout) ? 0 : 1;
+}
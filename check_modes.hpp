@@ -0,0 +1,30 @@
+#ifndef _CHECK_MODES_HPP_
+#define _CHECK_MODES_HPP_
+
+#include "checker_context.hpp"
+#include <ostream>
+#include <cstddef>
+
+// the checks a run of the checker makes, one for each mode but the batch. each returns the exit status of the run.
+// path nullptr reads standard input.
+
+// checks one program, printing to out what the check prints and to err why the program could not be checked.
+int check_program(const char* path, const check_options& options, std::ostream& out, std::ostream& err);
+
+// --stream: checks the program as it is read, a chunk at a time.
+int check_stream(const char* path, const check_options& options);
+
+// --cache: checks the program against the results kept in cache_path for the version checked before it.
+int check_cached(const char* path, const char* cache_path, const check_options& options);
+
+// --parallel: checks the function bodies on workers threads. flex cannot lex ahead of the parse to split the program,
+// so with flex, the default, the check is sequential and --hand-lexer or --token-buffer is what makes it parallel.
+int check_parallel(const char* path, const check_options& options, std::size_t workers);
+
+// --serve: answers checks on a Unix socket until stopped.
+int serve(const char* socket_path, const check_options& options, std::size_t workers, std::size_t queue_limit);
+
+// --load: sends the program to a server from clients connections, requests times in all, and reports the latencies.
+int generate_load(const char* socket_path, const char* path, std::size_t clients, std::size_t requests);
+
+#endif
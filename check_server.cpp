@@ -0,0 +1,349 @@
+#include "check_server.hpp"
+#include "parser.tab.hpp"
+#include "socket_frames.hpp"
+#include "source_buffer.hpp"
+#include "output.hpp"
+#include <sstream>
+#include <memory>
+#include <system_error>
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <csignal>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+using std::size_t;
+using std::string;
+using std::vector;
+
+// written to the wake pipe in place of a connection.
+static constexpr int stop_marker = -1;
+static constexpr int space_marker = -2;
+
+// an answer not taken within this long drops the connection, rather than holding its worker.
+static constexpr timeval send_timeout{ 10, 0 };
+
+// write end of the wake pipe of the running server, for the stop signal handler.
+static int stop_pipe = -1;
+
+static void request_stop(int)
+{
+    int stop = stop_marker;
+    ssize_t ignored = write(stop_pipe, &stop, sizeof(stop));
+    (void)ignored;
+}
+
+check_server::check_server(const char* path, const check_options& options, size_t worker_count, size_t queue_limit):
+    path(path), options(options), worker_count(worker_count != 0 ? worker_count : std::max(std::thread::hardware_concurrency(), 1u)),
+    queue_limit(std::max<size_t>(queue_limit, 1)), listener(-1), wake{ -1, -1 }, connections(), held(), queue(), lock(), queued(), stopping(false), workers()
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+
+    if (this->path.size() >= sizeof(address.sun_path))
+    {
+        throw std::invalid_argument("socket path too long: " + this->path);
+    }
+
+    std::memcpy(address.sun_path, path, this->path.size());
+
+    listener = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    if (listener < 0)
+    {
+        throw std::system_error(errno, std::generic_category(), "socket");
+    }
+
+    // a socket left behind by a server that did not stop cleanly.
+    unlink(path);
+
+    if (bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, SOMAXCONN) != 0)
+    {
+        throw std::system_error(errno, std::generic_category(), this->path);
+    }
+
+    if (pipe(wake) != 0)
+    {
+        throw std::system_error(errno, std::generic_category(), "pipe");
+    }
+}
+
+check_server::~check_server()
+{
+    for (int fd : { listener, wake[0], wake[1] })
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+    }
+}
+
+bool check_server::queue_full()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return queue.size() >= queue_limit;
+}
+
+void check_server::dispatch(int fd)
+{
+    // only the workers take from the queue, so it cannot fill up between the check and the push.
+    if (queue_full())
+    {
+        held.push_back(fd);
+        return;
+    }
+
+    connection& conn = connections.at(fd);
+    string text;
+    bool broken = false;
+
+    if (socket_frames::extract(conn.input, text, broken))
+    {
+        conn.busy = true;
+
+        std::lock_guard<std::mutex> guard(lock);
+        queue.push_back({ fd, std::move(text) });
+        queued.notify_one();
+    }
+    else if (broken)
+    {
+        close_connection(fd);
+    }
+}
+
+void check_server::dispatch_held()
+{
+    while (held.empty() == false && queue_full() == false)
+    {
+        int fd = held.front();
+        held.pop_front();
+
+        // a held connection may have been closed since, its descriptor is then dispatched harmlessly or not at all.
+        if (connections.count(fd) != 0 && connections.at(fd).busy == false)
+        {
+            dispatch(fd);
+        }
+    }
+}
+
+void check_server::close_connection(int fd)
+{
+    close(fd);
+    connections.erase(fd);
+}
+
+void check_server::work()
+{
+    std::unique_ptr<source_buffer> source;
+    std::unique_ptr<checker_context> context;
+
+    while (true)
+    {
+        request next;
+
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            queued.wait(guard, [&]() { return stopping || queue.empty() == false; });
+
+            if (queue.empty())
+            {
+                return;
+            }
+
+            bool was_full = queue.size() >= queue_limit;
+
+            next = std::move(queue.front());
+            queue.pop_front();
+
+            if (was_full)
+            {
+                int space = space_marker;
+                ssize_t ignored = write(wake[1], &space, sizeof(space));
+                (void)ignored;
+            }
+        }
+
+        std::ostringstream out;
+
+        output::set_stream(out);
+        output::set_max_errors(options.max_errors);
+
+        try
+        {
+            std::unique_ptr<source_buffer> next_source(new source_buffer(next.text.data(), next.text.size()));
+
+            // the context is kept, so the global scope and its built-ins are set up once per worker.
+            if (context == nullptr)
+            {
+                context.reset(new checker_context(*next_source, options.lexer));
+                context->keep_functions = options.check_only == false;
+                context->open_global_scope();
+            }
+            else
+            {
+                context->reset(*next_source);
+            }
+
+            source = std::move(next_source);
+
+            // a parse only fails when error recovery gave up, after the syntax error was reported.
+            if (parse_program(*context) == 0)
+            {
+                context->print_current_scope();
+            }
+        }
+        catch (const output::check_aborted&)
+        {
+        }
+        catch (const std::exception&)
+        {
+            // the command line check prints nothing to stdout for a source it cannot set up.
+            context.reset();
+        }
+
+        // the poll thread then sees the connection end and closes it.
+        if (socket_frames::write(next.fd, out.str()) == false)
+        {
+            shutdown(next.fd, SHUT_RDWR);
+        }
+
+        ssize_t ignored = write(wake[1], &next.fd, sizeof(next.fd));
+        (void)ignored;
+    }
+}
+
+void check_server::run()
+{
+    stop_pipe = wake[1];
+
+    struct sigaction action{};
+    action.sa_handler = request_stop;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+
+    for (size_t i = 0; i < worker_count; i++)
+    {
+        workers.emplace_back(&check_server::work, this);
+    }
+
+    bool stop = false;
+    vector<pollfd> polled;
+
+    while (stop == false)
+    {
+        polled.clear();
+        polled.push_back({ wake[0], POLLIN, 0 });
+        polled.push_back({ listener, POLLIN, 0 });
+
+        // a busy connection is left alone until its answer is written, and none is read while the queue is full.
+        if (queue_full() == false)
+        {
+            for (const auto& [fd, conn] : connections)
+            {
+                if (conn.busy == false)
+                {
+                    polled.push_back({ fd, POLLIN, 0 });
+                }
+            }
+        }
+
+        if (poll(polled.data(), polled.size(), -1) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            break;
+        }
+
+        if (polled[0].revents & POLLIN)
+        {
+            int handed[64];
+            ssize_t count = read(wake[0], handed, sizeof(handed));
+
+            for (ssize_t i = 0; i < count / static_cast<ssize_t>(sizeof(int)); i++)
+            {
+                if (handed[i] == stop_marker)
+                {
+                    stop = true;
+                    continue;
+                }
+
+                if (handed[i] == space_marker)
+                {
+                    continue;
+                }
+
+                // the next request may already be buffered, it is dispatched after those held back before it.
+                connections.at(handed[i]).busy = false;
+                held.push_back(handed[i]);
+            }
+
+            dispatch_held();
+        }
+
+        if (polled[1].revents & POLLIN)
+        {
+            int fd = accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+
+            if (fd >= 0)
+            {
+                setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &send_timeout, sizeof(send_timeout));
+                connections[fd] = { string(), false };
+            }
+        }
+
+        for (size_t i = 2; i < polled.size(); i++)
+        {
+            if (polled[i].revents == 0)
+            {
+                continue;
+            }
+
+            char chunk[64 * 1024];
+            ssize_t count = recv(polled[i].fd, chunk, sizeof(chunk), 0);
+
+            if (count < 0 && errno == EINTR)
+            {
+                continue;
+            }
+
+            if (count <= 0)
+            {
+                close_connection(polled[i].fd);
+                continue;
+            }
+
+            connections.at(polled[i].fd).input.append(chunk, static_cast<size_t>(count));
+            dispatch(polled[i].fd);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+        queued.notify_all();
+    }
+
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+
+    workers.clear();
+
+    while (connections.empty() == false)
+    {
+        close_connection(connections.begin()->first);
+    }
+
+    unlink(path.c_str());
+    stop_pipe = -1;
+}
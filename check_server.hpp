@@ -0,0 +1,82 @@
+#ifndef _CHECK_SERVER_HPP_
+#define _CHECK_SERVER_HPP_
+
+#include "checker_context.hpp"
+#include <string>
+#include <deque>
+#include <vector>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+
+// checks programs sent over a local socket, so the process and its workers outlive any single check.
+// a request is a socket_frames message holding the program text, answered by one holding what the command line check prints.
+// a connection may send any number of requests, a new one is read only after the previous one was answered.
+// one thread reads the connections and queues complete requests, a fixed number of workers check them.
+// while the queue is full no connection is read, and those holding a complete request wait for a worker to take one.
+// a client that stops reading its answer for ten seconds is disconnected, which frees the worker writing it.
+class check_server
+{
+    private:
+
+    struct connection
+    {
+        std::string input;
+        bool busy;
+    };
+
+    struct request
+    {
+        int fd;
+        std::string text;
+    };
+
+    const std::string path;
+    const check_options options;
+    const std::size_t worker_count;
+    const std::size_t queue_limit;
+    int listener;
+
+    // workers hand answered connections back through this pipe, and write -2 to it when they take from a full queue.
+    // a stop signal writes -1 to it.
+    int wake[2];
+
+    std::unordered_map<int, connection> connections;
+
+    // connections left to dispatch once the queue has space, in the order they were held back.
+    std::deque<int> held;
+
+    std::deque<request> queue;
+    std::mutex lock;
+    std::condition_variable queued;
+    bool stopping;
+    std::vector<std::thread> workers;
+
+    bool queue_full();
+
+    // queues the next complete request of a connection that is not busy, or closes it when its input is broken.
+    // while the queue is full the connection is held back instead.
+    void dispatch(int fd);
+
+    // dispatches the held connections while the queue has space.
+    void dispatch_held();
+
+    void close_connection(int fd);
+
+    void work();
+
+    public:
+
+    check_server(const char* path, const check_options& options, std::size_t worker_count, std::size_t queue_limit);
+    ~check_server();
+
+    check_server(const check_server& other) = delete;
+    check_server& operator=(const check_server& other) = delete;
+
+    // serves until SIGINT or SIGTERM, then answers the queued requests and removes the socket.
+    void run();
+};
+
+#endif
@@ -0,0 +1,245 @@
+#include "checker_context.hpp"
+#include "scanner.hpp"
+#include "lexer.hpp"
+#include "token_buffer.hpp"
+#include "source_stream.hpp"
+#include "generic_syntax.hpp"
+#include "output.hpp"
+#include <string>
+
+using std::size_t;
+using std::vector;
+
+checker_context::checker_context(source_buffer& source, lexer_kind kind):
+    source(&source), owned_index(source), index(owned_index), kind(kind), hand_lexer(), tokens(), reader(), stream(), scanner(nullptr), function_mark(), nodes(), root(nullptr), symtab(), token_offset(0), identifier_count(0), whole_program(true), keep_functions(true)
+{
+    start_lexer();
+}
+
+checker_context::checker_context(source_buffer& source, const source_index& index, const token_buffer& tokens):
+    source(&source), owned_index(), index(index), kind(lexer_kind::Buffered), hand_lexer(), tokens(), reader(new token_reader(tokens)), stream(),
+    scanner(nullptr), function_mark(), nodes(), root(nullptr), symtab(), token_offset(0), identifier_count(0), whole_program(true), keep_functions(true)
+{
+}
+
+checker_context::checker_context():
+    source(nullptr), owned_index(), index(owned_index), kind(lexer_kind::Hand), hand_lexer(), tokens(), reader(), stream(new source_stream(owned_index)), scanner(nullptr), function_mark(), nodes(), root(nullptr), symtab(), token_offset(0), identifier_count(0), whole_program(true), keep_functions(false)
+{
+}
+
+checker_context::~checker_context()
+{
+    if (scanner != nullptr)
+    {
+        destroy_scanner(scanner);
+    }
+}
+
+void checker_context::start_lexer()
+{
+    switch (kind)
+    {
+        case lexer_kind::Buffered:
+        {
+            tokens.reset(new token_buffer(*source));
+            lexer(*source).tokenize(*tokens);
+            reader.reset(new token_reader(*tokens));
+            break;
+        }
+
+        case lexer_kind::Hand:
+        {
+            hand_lexer.reset(new lexer(*source));
+            break;
+        }
+
+        case lexer_kind::Flex:
+        {
+            if (scanner != nullptr)
+            {
+                destroy_scanner(scanner);
+            }
+
+            source->make_writable();
+            scanner = create_scanner(*this, *source);
+            break;
+        }
+    }
+}
+
+void checker_context::open_global_scope()
+{
+    symtab.open_scope();
+    symtab.add_function("print", type_kind::Void, vector<type_kind>{ type_kind::String });
+    symtab.add_function("printi", type_kind::Void, vector<type_kind>{ type_kind::Int });
+}
+
+void checker_context::reset(source_buffer& source)
+{
+    this->source = &source;
+    owned_index.clear();
+    owned_index.append(source.data(), source.size());
+    start_lexer();
+
+    nodes.clear();
+    function_mark.reset();
+    root = nullptr;
+    token_offset = 0;
+    identifier_count = 0;
+    whole_program = true;
+
+    // the built-ins are the first two symbols of the global scope.
+    symtab.reset(2);
+}
+
+void checker_context::close_global_scope()
+{
+    print_current_scope();
+    symtab.close_scope();
+}
+
+void checker_context::print_current_scope() const
+{
+    output::end_scope();
+
+    // reused by every dump on the thread, so printing a scope allocates nothing once the line has grown.
+    static thread_local std::string line;
+
+    for (const symbol* sym : symtab.current_scope().get_symbols())
+    {
+        line.clear();
+        sym->append_to(line);
+        output::stream() << line << std::endl;
+    }
+}
+
+int checker_context::next_token(YYSTYPE* value)
+{
+    int kind = lex(value);
+
+    if (kind == ID)
+    {
+        value->token->id = symtab.intern(value->token->text);
+        identifier_count++;
+    }
+
+    return kind;
+}
+
+int checker_context::lex(YYSTYPE* value)
+{
+    if (scanner != nullptr)
+    {
+        return flex_lex(value, scanner);
+    }
+
+    yytoken_kind_t kind;
+
+    if (reader != nullptr)
+    {
+        kind = reader->next(value, nodes);
+        token_offset = reader->last_offset();
+    }
+    else if (stream != nullptr)
+    {
+        kind = stream->next(value, nodes);
+
+        if (kind == YYEMPTY)
+        {
+            return kind;
+        }
+
+        token_offset = stream->last_offset();
+    }
+    else
+    {
+        kind = hand_lexer->next(value, nodes);
+        token_offset = hand_lexer->last_offset();
+    }
+
+    // YYerror makes the parser recover without reporting a syntax error as well.
+    if (kind == YYUNDEF)
+    {
+        output::error_lex(current_line());
+        return YYerror;
+    }
+
+    return kind;
+}
+
+void checker_context::append_source(const char* data, size_t size)
+{
+    stream->append(data, size);
+}
+
+void checker_context::finish_source()
+{
+    stream->finish();
+}
+
+void checker_context::lex_range(size_t begin, size_t end)
+{
+    nodes.clear();
+    function_mark.reset();
+    root = nullptr;
+    hand_lexer.reset(new lexer(source->data() + begin, source->data() + end, begin, true));
+}
+
+void checker_context::lex_tokens(size_t first, size_t last, size_t end)
+{
+    nodes.clear();
+    function_mark.reset();
+    root = nullptr;
+    reader->select(first, last, static_cast<std::uint32_t>(end));
+}
+
+list_syntax<function_declaration_syntax>* checker_context::complete_function(list_syntax<function_declaration_syntax>* functions, function_declaration_syntax* function)
+{
+    if (keep_functions)
+    {
+        return functions->push_back(function);
+    }
+
+    // the reduction reads no lookahead, so everything allocated since the previous function belongs to this one.
+    // the first function is kept, the list of functions was allocated before it.
+    if (function_mark.has_value())
+    {
+        nodes.rewind(*function_mark);
+    }
+    else
+    {
+        function_mark = nodes.get_mark();
+    }
+
+    if (stream != nullptr)
+    {
+        stream->release(token_offset);
+    }
+
+    return functions;
+}
+
+const char* checker_context::source_begin() const
+{
+    return source->data();
+}
+
+size_t checker_context::source_size() const
+{
+    return source->size();
+}
+
+int checker_context::line_of(const syntax_token* token) const
+{
+    return index.line_of(token->offset);
+}
+
+int checker_context::line_of(size_t offset) const
+{
+    return index.line_of(offset);
+}
+
+int checker_context::current_line() const
+{
+    return index.line_of(token_offset);
+}
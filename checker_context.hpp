@@ -0,0 +1,147 @@
+#ifndef _CHECKER_CONTEXT_HPP_
+#define _CHECKER_CONTEXT_HPP_
+
+#include "symbol_table.hpp"
+#include "source_buffer.hpp"
+#include "source_index.hpp"
+#include "syntax_token.hpp"
+#include "syntax_arena.hpp"
+#include <memory>
+#include <optional>
+#include <cstddef>
+
+union YYSTYPE;
+typedef union YYSTYPE YYSTYPE;
+class lexer;
+class token_buffer;
+class token_reader;
+class source_stream;
+class function_declaration_syntax;
+class root_syntax;
+template<typename element_type> class list_syntax;
+
+enum class lexer_kind { Flex, Hand, Buffered };
+
+// how a program is checked, as selected on the command line.
+struct check_options
+{
+    lexer_kind lexer = lexer_kind::Flex;
+
+    // diagnostics reported before the check stops. above 1 the parser recovers from syntax errors.
+    std::size_t max_errors = 1;
+
+    // releases the syntax of each function as soon as it is checked, so memory is bound by the largest function.
+    bool check_only = false;
+
+    // reports the size of the syntax tree of a complete check, as allocated and as lowered to a flat_syntax.
+    bool syntax_stats = false;
+
+    // reports the identifiers lexed and the names resolved through the symbol table, which should be one per identifier and one for main.
+    bool lookup_stats = false;
+};
+
+// everything a single check works on: the source and its index, the selected lexer, the position of the last token and the symbol table.
+// checks with separate contexts share no state, so they may run on different threads.
+class checker_context
+{
+    private:
+
+    source_buffer* source;
+
+    // the index of the source, which index refers to unless it is shared with other contexts.
+    source_index owned_index;
+    const source_index& index;
+
+    const lexer_kind kind;
+    std::unique_ptr<lexer> hand_lexer;
+    std::unique_ptr<token_buffer> tokens;
+    std::unique_ptr<token_reader> reader;
+    std::unique_ptr<source_stream> stream;
+    void* scanner;
+
+    // where the syntax of a released function starts, every completed function is released back to it.
+    std::optional<syntax_arena::mark> function_mark;
+
+    // (re)creates the selected lexer over the whole source.
+    void start_lexer();
+
+    // next token of the selected lexer.
+    int lex(YYSTYPE* value);
+
+    public:
+
+    // tokens and syntax nodes of the current parse.
+    syntax_arena nodes;
+
+    // the tree of the last parse that reached the end of the program, until the arena is cleared.
+    const root_syntax* root;
+
+    symbol_table symtab;
+    std::size_t token_offset;
+
+    // identifier tokens handed to the parser.
+    std::size_t identifier_count;
+
+    // false while the functions of a program are parsed one at a time, main is then checked after the last of them.
+    bool whole_program;
+
+    // false when the syntax of each function is released once it is checked, which a streamed source always is.
+    bool keep_functions;
+
+    checker_context(source_buffer& source, lexer_kind kind);
+
+    // a check of a source already indexed and lexed into tokens, which only reads them. it starts with the whole buffer.
+    // the index and the tokens must outlive the context, several contexts may read them at once from different threads.
+    checker_context(source_buffer& source, const source_index& index, const token_buffer& tokens);
+
+    // a check of text that arrives in chunks through append_source, lexed by the hand lexer.
+    checker_context();
+
+    ~checker_context();
+
+    checker_context(const checker_context& other) = delete;
+    checker_context& operator=(const checker_context& other) = delete;
+
+    // global scope with the print and printi built-ins.
+    void open_global_scope();
+
+    // continues with another program. the global scope stays open and keeps its built-ins, everything else is dropped.
+    // not for a context over a shared index and tokens.
+    void reset(source_buffer& source);
+
+    // prints and closes the global scope.
+    void close_global_scope();
+
+    // prints the symbols of the innermost scope, as it closes.
+    void print_current_scope() const;
+
+    // next token, or YYEMPTY when streamed text does not complete it yet. identifiers are interned into the symbol table.
+    int next_token(YYSTYPE* value);
+
+    void append_source(const char* data, std::size_t size);
+
+    void finish_source();
+
+    // makes the hand lexer continue with the source text between the offsets begin and end, as a new parse.
+    // the syntax of the previous parse is released.
+    void lex_range(std::size_t begin, std::size_t end);
+
+    // the same for a context over a shared index and tokens: continues with the tokens [first, last), and END at the offset end.
+    void lex_tokens(std::size_t first, std::size_t last, std::size_t end);
+
+    // called as each function reduces. keeps it in functions, unless functions are not kept, in which case its syntax is released,
+    // together with the text before the last token when the source is streamed.
+    list_syntax<function_declaration_syntax>* complete_function(list_syntax<function_declaration_syntax>* functions, function_declaration_syntax* function);
+
+    const char* source_begin() const;
+    std::size_t source_size() const;
+
+    int line_of(const syntax_token* token) const;
+
+    int line_of(std::size_t offset) const;
+
+    // line of the last token handed to the parser.
+    int current_line() const;
+};
+
+#endif
@@ -0,0 +1,171 @@
+#include "command_line.hpp"
+#include <iostream>
+#include <fstream>
+#include <string_view>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+using std::string;
+
+// reads the count given to option, which must be the whole of text. prints why it is not one and returns false otherwise.
+static bool read_count(const char* option, const char* text, std::size_t& count)
+{
+    const char* end = text + std::strlen(text);
+    auto [last, error] = std::from_chars(text, end, count);
+
+    if (error != std::errc() || last != end)
+    {
+        std::cerr << option << " takes a count, not '" << text << "'" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+command_line::command_line():
+    manifest_paths(), mode(check_mode::Program), options(), path(nullptr), paths(), cache_path(nullptr), serve_path(nullptr), load_path(nullptr),
+    workers(0), queue_limit(64), clients(1), requests(10000)
+{
+}
+
+bool command_line::parse(int argc, char* argv[])
+{
+    bool batch = false;
+    bool stream = false;
+    bool parallel = false;
+
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::string_view(argv[i]) == "--hand-lexer")
+        {
+            options.lexer = lexer_kind::Hand;
+        }
+        else if (std::string_view(argv[i]) == "--flex-lexer")
+        {
+            options.lexer = lexer_kind::Flex;
+        }
+        else if (std::string_view(argv[i]) == "--token-buffer")
+        {
+            options.lexer = lexer_kind::Buffered;
+        }
+        else if (std::string_view(argv[i]) == "--max-errors" && i + 1 < argc)
+        {
+            if (read_count(argv[i], argv[i + 1], options.max_errors) == false)
+            {
+                return false;
+            }
+
+            options.max_errors = std::max<std::size_t>(options.max_errors, 1);
+            i++;
+        }
+        else if (std::string_view(argv[i]) == "--stream")
+        {
+            stream = true;
+        }
+        else if (std::string_view(argv[i]) == "--cache" && i + 1 < argc)
+        {
+            cache_path = argv[++i];
+        }
+        else if (std::string_view(argv[i]) == "--serve" && i + 1 < argc)
+        {
+            serve_path = argv[++i];
+        }
+        else if (std::string_view(argv[i]) == "--workers" && i + 1 < argc)
+        {
+            if (read_count(argv[i], argv[i + 1], workers) == false)
+            {
+                return false;
+            }
+
+            i++;
+        }
+        else if (std::string_view(argv[i]) == "--queue" && i + 1 < argc)
+        {
+            if (read_count(argv[i], argv[i + 1], queue_limit) == false)
+            {
+                return false;
+            }
+
+            i++;
+        }
+        else if (std::string_view(argv[i]) == "--load" && i + 1 < argc)
+        {
+            load_path = argv[++i];
+        }
+        else if (std::string_view(argv[i]) == "--clients" && i + 1 < argc)
+        {
+            if (read_count(argv[i], argv[i + 1], clients) == false)
+            {
+                return false;
+            }
+
+            i++;
+        }
+        else if (std::string_view(argv[i]) == "--requests" && i + 1 < argc)
+        {
+            if (read_count(argv[i], argv[i + 1], requests) == false)
+            {
+                return false;
+            }
+
+            i++;
+        }
+        else if (std::string_view(argv[i]) == "--parallel")
+        {
+            parallel = true;
+        }
+        else if (std::string_view(argv[i]) == "--check-only")
+        {
+            options.check_only = true;
+        }
+        else if (std::string_view(argv[i]) == "--syntax-stats")
+        {
+            options.syntax_stats = true;
+        }
+        else if (std::string_view(argv[i]) == "--lookup-stats")
+        {
+            options.lookup_stats = true;
+        }
+        else if (std::string_view(argv[i]) == "--batch")
+        {
+            batch = true;
+        }
+        else if (std::string_view(argv[i]) == "--manifest" && i + 1 < argc)
+        {
+            std::ifstream manifest(argv[++i]);
+
+            if (manifest.is_open() == false)
+            {
+                std::cerr << "cannot open manifest " << argv[i] << std::endl;
+                return false;
+            }
+
+            for (string line; std::getline(manifest, line);)
+            {
+                if (line.empty() == false)
+                {
+                    paths.push_back(manifest_paths.emplace_back(line).c_str());
+                }
+            }
+
+            batch = true;
+        }
+        else
+        {
+            path = argv[i];
+            paths.push_back(argv[i]);
+        }
+    }
+
+    if (serve_path != nullptr) mode = check_mode::Serve;
+    else if (load_path != nullptr) mode = check_mode::Load;
+    else if (batch) mode = check_mode::Batch;
+    else if (stream) mode = check_mode::Stream;
+    else if (parallel) mode = check_mode::Parallel;
+    else if (cache_path != nullptr) mode = check_mode::Cached;
+    else mode = check_mode::Program;
+
+    return true;
+}
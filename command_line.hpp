@@ -0,0 +1,49 @@
+#ifndef _COMMAND_LINE_HPP_
+#define _COMMAND_LINE_HPP_
+
+#include "checker_context.hpp"
+#include <list>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+// what a run of the checker does, the first of these that the command line asks for.
+enum class check_mode { Serve, Load, Batch, Stream, Parallel, Cached, Program };
+
+// the arguments of main: the mode, the options of the check, and the files and counts the mode takes.
+class command_line
+{
+    private:
+
+    // the paths read from manifests, which paths points into.
+    std::list<std::string> manifest_paths;
+
+    public:
+
+    check_mode mode;
+    check_options options;
+
+    // the last file named, nullptr for standard input. a batch checks every file named, and every one its manifests list.
+    const char* path;
+    std::vector<const char*> paths;
+
+    const char* cache_path;
+    const char* serve_path;
+    const char* load_path;
+
+    // 0 workers sizes the pool to the machine.
+    std::size_t workers;
+    std::size_t queue_limit;
+    std::size_t clients;
+    std::size_t requests;
+
+    command_line();
+
+    command_line(const command_line& other) = delete;
+    command_line& operator=(const command_line& other) = delete;
+
+    // reads argv. prints why an argument is not valid and returns false otherwise.
+    bool parse(int argc, char* argv[]);
+};
+
+#endif
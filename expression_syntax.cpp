@@ -4,72 +4,48 @@
 #include <stdexcept>
 
 using std::string;
+using std::string_view;
 using std::vector;
 
-cast_expression::cast_expression(type_syntax* destination_type, expression_syntax* expression):
-    expression_syntax(destination_type->kind), destination_type(destination_type), expression(expression)
+cast_expression::cast_expression(checker_context& context, type_syntax* destination_type, expression_syntax* expression):
+    expression_syntax(syntax_kind::Cast, destination_type->kind), destination_type(destination_type), expression(expression)
 {
-    if (expression->is_numeric() == false || destination_type->is_numeric() == false)
+    if (inherit_poison({ expression }) == false && (expression->is_numeric() == false || destination_type->is_numeric() == false))
     {
-        output::error_mismatch(destination_type->type_token->position);
+        output::error_mismatch(context.line_of(destination_type->type_token));
+        poison();
     }
 
     push_back_child(destination_type);
     push_back_child(expression);
 }
 
-cast_expression::~cast_expression()
+not_expression::not_expression(checker_context& context, syntax_token* not_token, expression_syntax* expression):
+    expression_syntax(syntax_kind::Not, type_kind::Bool), not_token(not_token), expression(expression)
 {
-    for (syntax_base* child : get_children())
+    if (inherit_poison({ expression }) == false && expression->return_type != type_kind::Bool)
     {
-        delete child;
-    }
-}
-
-not_expression::not_expression(syntax_token* not_token, expression_syntax* expression):
-    expression_syntax(type_kind::Bool), not_token(not_token), expression(expression)
-{
-    if (expression->return_type != type_kind::Bool)
-    {
-        output::error_mismatch(not_token->position);
+        output::error_mismatch(context.line_of(not_token));
+        poison();
     }
 
     push_back_child(expression);
 }
 
-not_expression::~not_expression()
-{
-    for (syntax_base* child : get_children())
-    {
-        delete child;
-    }
-
-    delete not_token;
-}
-
-logical_expression::logical_expression(expression_syntax* left, syntax_token* oper_token, expression_syntax* right):
-    expression_syntax(type_kind::Bool), left(left), oper_token(oper_token), right(right), oper(parse_operator(oper_token->text))
+logical_expression::logical_expression(checker_context& context, expression_syntax* left, syntax_token* oper_token, expression_syntax* right):
+    expression_syntax(syntax_kind::Logical, type_kind::Bool), left(left), oper_token(oper_token), right(right), oper(parse_operator(oper_token->text))
 {
-    if (left->return_type != type_kind::Bool || right->return_type != type_kind::Bool)
+    if (inherit_poison({ left, right }) == false && (left->return_type != type_kind::Bool || right->return_type != type_kind::Bool))
     {
-        output::error_mismatch(oper_token->position);
+        output::error_mismatch(context.line_of(oper_token));
+        poison();
     }
 
     push_back_child(left);
     push_back_child(right);
 }
 
-logical_expression::~logical_expression()
-{
-    for (syntax_base* child : get_children())
-    {
-        delete child;
-    }
-
-    delete oper_token;
-}
-
-logical_expression::operator_kind logical_expression::parse_operator(string str)
+logical_expression::operator_kind logical_expression::parse_operator(string_view str)
 {
     if (str == "and") return operator_kind::And;
     if (str == "or") return operator_kind::Or;
@@ -77,29 +53,20 @@ logical_expression::operator_kind logical_expression::parse_operator(string str)
     throw std::invalid_argument("unknown oper");
 }
 
-arithmetic_expression::arithmetic_expression(expression_syntax* left, syntax_token* oper_token, expression_syntax* right):
-    expression_syntax(types::cast_up(left->return_type, right->return_type)), left(left), oper_token(oper_token), right(right), oper(parse_operator(oper_token->text))
+arithmetic_expression::arithmetic_expression(checker_context& context, expression_syntax* left, syntax_token* oper_token, expression_syntax* right):
+    expression_syntax(syntax_kind::Arithmetic, types::cast_up(left->return_type, right->return_type)), left(left), oper_token(oper_token), right(right), oper(parse_operator(oper_token->text))
 {
-    if (left->is_numeric() == false || right->is_numeric() == false)
+    if (inherit_poison({ left, right }) == false && (left->is_numeric() == false || right->is_numeric() == false))
     {
-        output::error_mismatch(oper_token->position);
+        output::error_mismatch(context.line_of(oper_token));
+        poison();
     }
 
     push_back_child(left);
     push_back_child(right);
 }
 
-arithmetic_expression::~arithmetic_expression()
-{
-    for (syntax_base* child : get_children())
-    {
-        delete child;
-    }
-
-    delete oper_token;
-}
-
-arithmetic_expression::operator_kind arithmetic_expression::parse_operator(string str)
+arithmetic_expression::operator_kind arithmetic_expression::parse_operator(string_view str)
 {
     if (str == "+") return operator_kind::Add;
     if (str == "-") return operator_kind::Sub;
@@ -109,29 +76,20 @@ arithmetic_expression::operator_kind arithmetic_expression::parse_operator(strin
     throw std::invalid_argument("unknown oper");
 }
 
-relational_expression::relational_expression(expression_syntax* left, syntax_token* oper_token, expression_syntax* right):
-    expression_syntax(type_kind::Bool), left(left), oper_token(oper_token), right(right), oper(parse_operator(oper_token->text))
+relational_expression::relational_expression(checker_context& context, expression_syntax* left, syntax_token* oper_token, expression_syntax* right):
+    expression_syntax(syntax_kind::Relational, type_kind::Bool), left(left), oper_token(oper_token), right(right), oper(parse_operator(oper_token->text))
 {
-    if (left->is_numeric() == false || right->is_numeric() == false)
+    if (inherit_poison({ left, right }) == false && (left->is_numeric() == false || right->is_numeric() == false))
     {
-        output::error_mismatch(oper_token->position);
+        output::error_mismatch(context.line_of(oper_token));
+        poison();
     }
 
     push_back_child(left);
     push_back_child(right);
 }
 
-relational_expression::~relational_expression()
-{
-    for (syntax_base* child : get_children())
-    {
-        delete child;
-    }
-
-    delete oper_token;
-}
-
-relational_expression::operator_kind relational_expression::parse_operator(string str)
+relational_expression::operator_kind relational_expression::parse_operator(string_view str)
 {
     if (str == "<") return operator_kind::Less;
     if (str == "<=") return operator_kind::LessEqual;
@@ -143,17 +101,19 @@ relational_expression::operator_kind relational_expression::parse_operator(strin
     throw std::invalid_argument("unknown oper");
 }
 
-conditional_expression::conditional_expression(expression_syntax* true_value, syntax_token* if_token, expression_syntax* condition, syntax_token* const else_token, expression_syntax* false_value):
-    expression_syntax(types::cast_up(true_value->return_type, false_value->return_type)), true_value(true_value), if_token(if_token), condition(condition), else_token(else_token), false_value(false_value)
+conditional_expression::conditional_expression(checker_context& context, expression_syntax* true_value, syntax_token* if_token, expression_syntax* condition, syntax_token* const else_token, expression_syntax* false_value):
+    expression_syntax(syntax_kind::Conditional, types::cast_up(true_value->return_type, false_value->return_type)), true_value(true_value), if_token(if_token), condition(condition), else_token(else_token), false_value(false_value)
 {
-    if (return_type == type_kind::Void)
+    if (inherit_poison({ true_value, condition, false_value }) == false && return_type == type_kind::Void)
     {
-        output::error_mismatch(if_token->position);
+        output::error_mismatch(context.line_of(if_token));
+        poison();
     }
 
-    if (condition->return_type != type_kind::Bool)
+    if (is_poisoned() == false && condition->return_type != type_kind::Bool)
     {
-        output::error_mismatch(if_token->position);
+        output::error_mismatch(context.line_of(if_token));
+        poison();
     }
 
     push_back_child(true_value);
@@ -161,130 +121,91 @@ conditional_expression::conditional_expression(expression_syntax* true_value, sy
     push_back_child(false_value);
 }
 
-conditional_expression::~conditional_expression()
+identifier_expression::identifier_expression(checker_context& context, syntax_token* identifier_token):
+    identifier_expression(context, identifier_token, context.symtab.get_symbol(identifier_token->id))
 {
-    for (syntax_base* child : get_children())
-    {
-        delete child;
-    }
-
-    delete if_token;
-    delete else_token;
 }
 
-identifier_expression::identifier_expression(syntax_token* identifier_token):
-    expression_syntax(get_return_type(identifier_token->text)), identifier_token(identifier_token), identifier(identifier_token->text)
+// the name is looked up once, by the public constructor, before the type of the expression is needed.
+identifier_expression::identifier_expression(checker_context& context, syntax_token* identifier_token, const symbol* found):
+    expression_syntax(syntax_kind::Identifier, resolve(found) != nullptr ? found->type : type_kind::Invalid), identifier_token(identifier_token), identifier(identifier_token->text), resolved(resolve(found))
 {
-    const symbol* symbol = symbol_table::instance().get_symbol(identifier);
-
-    if (symbol == nullptr || symbol->kind != symbol_kind::Variable)
+    if (resolved == nullptr)
     {
-        output::error_undef(identifier_token->position, identifier);
+        output::error_undef(context.line_of(identifier_token), identifier);
+        poison();
     }
 }
 
-type_kind identifier_expression::get_return_type(string identifier)
+const symbol* identifier_expression::resolve(const symbol* found)
 {
-    const symbol* symbol = symbol_table::instance().get_symbol(identifier);
-
-    if (symbol == nullptr || symbol->kind != symbol_kind::Variable)
-    {
-        return type_kind::Invalid;
-    }
-
-    return symbol->type;
+    return found != nullptr && found->kind == symbol_kind::Variable ? found : nullptr;
 }
 
-identifier_expression::~identifier_expression()
+invocation_expression::invocation_expression(checker_context& context, syntax_token* identifier_token):
+    invocation_expression(context, identifier_token, nullptr, context.symtab.get_symbol(identifier_token->id))
 {
-    for (syntax_base* child : get_children())
-    {
-        delete child;
-    }
-
-    delete identifier_token;
 }
 
-invocation_expression::invocation_expression(syntax_token* identifier_token):
-    expression_syntax(get_return_type(identifier_token->text)), identifier_token(identifier_token), identifier(identifier_token->text), arguments(nullptr)
+invocation_expression::invocation_expression(checker_context& context, syntax_token* identifier_token, list_syntax<expression_syntax>* arguments):
+    invocation_expression(context, identifier_token, arguments, context.symtab.get_symbol(identifier_token->id))
 {
-    const symbol* symbol = symbol_table::instance().get_symbol(identifier);
-
-    if (symbol == nullptr || symbol->kind != symbol_kind::Function)
-    {
-        output::error_undef_func(identifier_token->position, identifier);
-    }
-
-    vector<type_kind> parameter_types = static_cast<const function_symbol*>(symbol)->parameter_types;
-
-    vector<string> params_str;
-
-    for (type_kind type : parameter_types)
-    {
-        params_str.push_back(types::to_string(type));
-    }
-
-    if (parameter_types.size() != 0)
-    {
-        output::error_prototype_mismatch(identifier_token->position, identifier, params_str);
-    }
 }
 
-invocation_expression::invocation_expression(syntax_token* identifier_token, list_syntax<expression_syntax>* arguments):
-    expression_syntax(get_return_type(identifier_token->text)), identifier_token(identifier_token), identifier(identifier_token->text), arguments(arguments)
+invocation_expression::invocation_expression(checker_context& context, syntax_token* identifier_token, list_syntax<expression_syntax>* arguments, const symbol* found):
+    expression_syntax(syntax_kind::Invocation, resolve(found) != nullptr ? found->type : type_kind::Invalid), identifier_token(identifier_token), identifier(identifier_token->text), arguments(arguments), resolved(resolve(found))
 {
-    const symbol* symbol = symbol_table::instance().get_symbol(identifier);
+    push_back_child(arguments);
 
-    if (symbol == nullptr || symbol->kind != symbol_kind::Function)
+    if (resolved == nullptr)
     {
-        output::error_undef_func(identifier_token->position, identifier);
+        output::error_undef_func(context.line_of(identifier_token), identifier);
+        poison();
+        return;
     }
 
-    vector<type_kind> parameter_types = static_cast<const function_symbol*>(symbol)->parameter_types;
-
-    vector<string> params_str;
+    const vector<type_kind>& parameter_types = resolved->parameter_types;
 
-    for (type_kind type : parameter_types)
+    if (parameter_types.size() != (arguments != nullptr ? arguments->size() : 0))
     {
-        params_str.push_back(types::to_string(type));
+        report_mismatch(context);
+        poison();
+        return;
     }
 
-    if (parameter_types.size() != arguments->size())
+    if (arguments == nullptr)
     {
-        output::error_prototype_mismatch(identifier_token->position, identifier, params_str);
+        return;
     }
 
-
     size_t i = 0;
     for (auto arg : *arguments)
     {
-        if (types::is_implictly_convertible(arg->return_type, parameter_types[i++]) == false)
+        type_kind parameter_type = parameter_types[i++];
+
+        if (arg->is_poisoned() == false && types::is_implictly_convertible(arg->return_type, parameter_type) == false)
         {
-            output::error_prototype_mismatch(identifier_token->position, identifier, params_str);
+            report_mismatch(context);
+            poison();
+            return;
         }
     }
-
-    push_back_child(arguments);
 }
 
-type_kind invocation_expression::get_return_type(string identifier)
+void invocation_expression::report_mismatch(checker_context& context) const
 {
-    const symbol* symbol = symbol_table::instance().get_symbol(identifier);
+    // the names of the parameter types are only needed for the diagnostic.
+    vector<string> params_str;
 
-    if (symbol == nullptr || symbol->kind != symbol_kind::Function)
+    for (type_kind type : resolved->parameter_types)
     {
-        return type_kind::Invalid;
+        params_str.emplace_back(types::to_string(type));
     }
 
-    return symbol->type;
+    output::error_prototype_mismatch(context.line_of(identifier_token), identifier, params_str);
 }
 
-invocation_expression::~invocation_expression()
+const function_symbol* invocation_expression::resolve(const symbol* found)
 {
-    for (syntax_base* child : get_children())
-    {
-        delete child;
-    }
-
-    delete identifier_token;
+    return found != nullptr && found->kind == symbol_kind::Function ? static_cast<const function_symbol*>(found) : nullptr;
 }
@@ -5,10 +5,13 @@
 #include "abstract_syntax.hpp"
 #include "generic_syntax.hpp"
 #include "output.hpp"
+#include "checker_context.hpp"
 #include <vector>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <stdexcept>
+#include <cstdint>
 
 template<typename literal_type> class literal_expression final: public expression_syntax
 {
@@ -17,8 +20,8 @@ template<typename literal_type> class literal_expression final: public expressio
     const syntax_token* const value_token;
     const literal_type value;
 
-    literal_expression(syntax_token* value_token):
-        expression_syntax(get_return_type()), value_token(value_token), value(get_literal_value(value_token))
+    literal_expression(checker_context& context, syntax_token* value_token):
+        expression_syntax(syntax_kind::Literal, get_return_type()), value_token(value_token), value(get_literal_value(context, value_token))
     {
     }
 
@@ -31,50 +34,40 @@ template<typename literal_type> class literal_expression final: public expressio
         if (std::is_same<literal_type, char>::value) return type_kind::Byte;
         if (std::is_same<literal_type, int>::value) return type_kind::Int;
         if (std::is_same<literal_type, bool>::value) return type_kind::Bool;
-        if (std::is_same<literal_type, std::string>::value) return type_kind::String;
+        if (std::is_same<literal_type, std::string_view>::value) return type_kind::String;
 
         throw std::runtime_error("invalid literal_type");
     }
 
-    inline literal_type get_literal_value(syntax_token* value_token) const
+    inline literal_type get_literal_value(checker_context& context, syntax_token* value_token) const
     {
         throw std::runtime_error("invalid literal_type");
     }
-
-    ~literal_expression()
-    {
-        for (syntax_base* child : get_children())
-        {
-            delete child;
-        }
-
-        delete value_token;
-    }
 };
 
-template<> inline int literal_expression<int>::get_literal_value(syntax_token* value_token) const
+template<> inline int literal_expression<int>::get_literal_value(checker_context&, syntax_token* value_token) const
 {
-    return std::stoi(value_token->text);
+    return std::stoi(std::string(value_token->text));
 }
 
-template<> inline char literal_expression<char>::get_literal_value(syntax_token* value_token) const
+template<> inline char literal_expression<char>::get_literal_value(checker_context& context, syntax_token* value_token) const
 {
-    int value = std::stoi(value_token->text);
+    int value = std::stoi(std::string(value_token->text));
 
     if (value < 0 || value > 255)
     {
-        output::error_byte_too_large(value_token->position, value_token->text);
+        output::error_byte_too_large(context.line_of(value_token), value_token->text);
     }
 
     return static_cast<char>(value);
 }
 
-template<> inline std::string literal_expression<std::string>::get_literal_value(syntax_token* value_token) const
+template<> inline std::string_view literal_expression<std::string_view>::get_literal_value(checker_context&, syntax_token* value_token) const
 {
-    return std::string(value_token->text);
+    return value_token->text;
 }
 
-template<> inline bool literal_expression<bool>::get_literal_value(syntax_token* value_token) const
+template<> inline bool literal_expression<bool>::get_literal_value(checker_context&, syntax_token* value_token) const
 {
     if (value_token->text == "true") return true;
     if (value_token->text == "false") return false;
@@ -89,8 +82,7 @@ class cast_expression final: public expression_syntax
     const type_syntax* const destination_type;
     const expression_syntax* const expression;
 
-    cast_expression(type_syntax* destination_type, expression_syntax* expression);
-    ~cast_expression();
+    cast_expression(checker_context& context, type_syntax* destination_type, expression_syntax* expression);
 
     cast_expression(const cast_expression& other) = delete;
     cast_expression& operator=(const cast_expression& other) = delete;
@@ -103,8 +95,7 @@ class not_expression final: public expression_syntax
     const syntax_token* const not_token;
     const expression_syntax* const expression;
 
-    not_expression(syntax_token* not_token, expression_syntax* expression);
-    ~not_expression();
+    not_expression(checker_context& context, syntax_token* not_token, expression_syntax* expression);
 
     not_expression(const not_expression& other) = delete;
     not_expression& operator=(const not_expression& other) = delete;
@@ -121,13 +112,12 @@ class logical_expression final: public expression_syntax
     const expression_syntax* const right;
     const operator_kind oper;
 
-    logical_expression(expression_syntax* left, syntax_token* oper_token, expression_syntax* right);
-    ~logical_expression();
+    logical_expression(checker_context& context, expression_syntax* left, syntax_token* oper_token, expression_syntax* right);
 
     logical_expression(const logical_expression& other) = delete;
     logical_expression& operator=(const logical_expression& other) = delete;
 
-    static operator_kind parse_operator(std::string str);
+    static operator_kind parse_operator(std::string_view str);
 };
 
 class arithmetic_expression final: public expression_syntax
@@ -141,13 +131,12 @@ class arithmetic_expression final: public expression_syntax
     const expression_syntax* const right;
     const operator_kind oper;
 
-    arithmetic_expression(expression_syntax* left, syntax_token* oper_token, expression_syntax* right);
-    ~arithmetic_expression();
+    arithmetic_expression(checker_context& context, expression_syntax* left, syntax_token* oper_token, expression_syntax* right);
 
     arithmetic_expression(const arithmetic_expression& other) = delete;
     arithmetic_expression& operator=(const arithmetic_expression& other) = delete;
 
-    static operator_kind parse_operator(std::string str);
+    static operator_kind parse_operator(std::string_view str);
 };
 
 class relational_expression final: public expression_syntax
@@ -161,13 +150,12 @@ class relational_expression final: public expression_syntax
     const expression_syntax* const right;
     const operator_kind oper;
 
-    relational_expression(expression_syntax* left, syntax_token* oper_token, expression_syntax* right);
-    ~relational_expression();
+    relational_expression(checker_context& context, expression_syntax* left, syntax_token* oper_token, expression_syntax* right);
 
     relational_expression(const relational_expression& other) = delete;
     relational_expression& operator=(const relational_expression& other) = delete;
 
-    static operator_kind parse_operator(std::string str);
+    static operator_kind parse_operator(std::string_view str);
 };
 
 class conditional_expression final: public expression_syntax
@@ -180,8 +168,7 @@ class conditional_expression final: public expression_syntax
     const syntax_token* const else_token;
     const expression_syntax* const false_value;
 
-    conditional_expression(expression_syntax* true_value, syntax_token* if_token, expression_syntax* condition, syntax_token* const else_token, expression_syntax* false_value);
-    ~conditional_expression();
+    conditional_expression(checker_context& context, expression_syntax* true_value, syntax_token* if_token, expression_syntax* condition, syntax_token* const else_token, expression_syntax* false_value);
 
     conditional_expression(const conditional_expression& other) = delete;
     conditional_expression& operator=(const conditional_expression& other) = delete;
@@ -196,17 +183,22 @@ class identifier_expression final: public expression_syntax
     public:
 
     const syntax_token* const identifier_token;
-    const std::string identifier;
+    const std::string_view identifier;
+
+    // the variable the name resolved to as the node was built, nullptr when there was none.
+    // variables are reused once their scope closes, so it is only meaningful while the scope of the variable is open.
+    const symbol* const resolved;
 
-    identifier_expression(syntax_token* identifier_token);
-    ~identifier_expression();
+    identifier_expression(checker_context& context, syntax_token* identifier_token);
 
     identifier_expression(const identifier_expression& other) = delete;
     identifier_expression& operator=(const identifier_expression& other) = delete;
 
     private:
 
-    static type_kind get_return_type(std::string identifier);
+    identifier_expression(checker_context& context, syntax_token* identifier_token, const symbol* found);
+
+    static const symbol* resolve(const symbol* found);
 };
 
 class invocation_expression final: public expression_syntax
@@ -214,19 +206,26 @@ class invocation_expression final: public expression_syntax
     public:
 
     const syntax_token* const identifier_token;
-    const std::string identifier;
+    const std::string_view identifier;
     const list_syntax<expression_syntax>* const arguments;
 
-    invocation_expression(syntax_token* identifier_token);
-    invocation_expression(syntax_token* identifier_token, list_syntax<expression_syntax>* arguments);
-    ~invocation_expression();
+    // the function the name resolved to as the node was built, nullptr when there was none.
+    const function_symbol* const resolved;
+
+    invocation_expression(checker_context& context, syntax_token* identifier_token);
+    invocation_expression(checker_context& context, syntax_token* identifier_token, list_syntax<expression_syntax>* arguments);
 
     invocation_expression(const invocation_expression& other) = delete;
     invocation_expression& operator=(const invocation_expression& other) = delete;
 
     private:
 
-    static type_kind get_return_type(std::string identifier);
+    // arguments is nullptr for an invocation without any.
+    invocation_expression(checker_context& context, syntax_token* identifier_token, list_syntax<expression_syntax>* arguments, const symbol* found);
+
+    void report_mismatch(checker_context& context) const;
+
+    static const function_symbol* resolve(const symbol* found);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,269 @@
+#include "flat_syntax.hpp"
+#include "generic_syntax.hpp"
+#include "expression_syntax.hpp"
+#include "statement_syntax.hpp"
+#include <algorithm>
+#include <utility>
+
+using std::size_t;
+using std::uint32_t;
+using std::vector;
+
+flat_syntax::flat_syntax(const syntax_base& root): nodes(), literals()
+{
+    // nodes still to lower, with the index of their parent. children are pushed in reverse, so they are lowered in order.
+    vector<std::pair<const syntax_base*, uint32_t>> pending{ { &root, none } };
+    vector<uint32_t> last_child;
+
+    while (pending.empty() == false)
+    {
+        auto [source, parent] = pending.back();
+        pending.pop_back();
+
+        uint32_t index = static_cast<uint32_t>(nodes.size());
+        nodes.push_back(lower(*source));
+        last_child.push_back(none);
+
+        if (parent != none)
+        {
+            if (last_child[parent] == none)
+            {
+                nodes[parent].first_child = index;
+            }
+            else
+            {
+                nodes[last_child[parent]].next_sibling = index;
+            }
+
+            last_child[parent] = index;
+        }
+
+        size_t first = pending.size();
+
+        for (const syntax_base* child : source->get_children())
+        {
+            pending.emplace_back(child, index);
+        }
+
+        std::reverse(pending.begin() + first, pending.end());
+    }
+}
+
+flat_syntax::node flat_syntax::lower(const syntax_base& source)
+{
+    node flat{ source.node_kind, static_cast<std::uint8_t>(type_kind::Invalid), none, none, none, none };
+
+    auto set_type = [&](type_kind type) { flat.type = static_cast<std::uint8_t>(type); };
+
+    switch (source.node_kind)
+    {
+        case syntax_kind::Root:
+        case syntax_kind::List:
+        case syntax_kind::Block:
+        case syntax_kind::ExpressionStatement:
+        {
+            break;
+        }
+
+        case syntax_kind::Function:
+        {
+            auto& function = static_cast<const function_declaration_syntax&>(source);
+            set_type(function.return_type->kind);
+            flat.offset = function.identifier_token->offset;
+            break;
+        }
+
+        case syntax_kind::Parameter:
+        {
+            auto& parameter = static_cast<const parameter_syntax&>(source);
+            set_type(parameter.type->kind);
+            flat.offset = parameter.identifier_token->offset;
+            break;
+        }
+
+        case syntax_kind::Type:
+        {
+            auto& type = static_cast<const type_syntax&>(source);
+            set_type(type.kind);
+            flat.offset = type.type_token->offset;
+            break;
+        }
+
+        case syntax_kind::If:
+        {
+            flat.offset = static_cast<const if_statement&>(source).if_token->offset;
+            break;
+        }
+
+        case syntax_kind::While:
+        {
+            flat.offset = static_cast<const while_statement&>(source).while_token->offset;
+            break;
+        }
+
+        case syntax_kind::Branch:
+        {
+            auto& branch = static_cast<const branch_statement&>(source);
+            flat.offset = branch.branch_token->offset;
+            flat.payload = static_cast<uint32_t>(branch.kind);
+            break;
+        }
+
+        case syntax_kind::Return:
+        {
+            flat.offset = static_cast<const return_statement&>(source).return_token->offset;
+            break;
+        }
+
+        case syntax_kind::Assignment:
+        {
+            flat.offset = static_cast<const assignment_statement&>(source).identifier_token->offset;
+            break;
+        }
+
+        case syntax_kind::Declaration:
+        {
+            auto& declaration = static_cast<const declaration_statement&>(source);
+            set_type(declaration.type->kind);
+            flat.offset = declaration.identifier_token->offset;
+            break;
+        }
+
+        case syntax_kind::Literal:
+        {
+            auto& expression = static_cast<const expression_syntax&>(source);
+            set_type(expression.return_type);
+
+            // the literal is an int, byte or bool, the text of a string is at its offset.
+            switch (expression.return_type)
+            {
+                case type_kind::Int:
+                {
+                    auto& literal = static_cast<const literal_expression<int>&>(source);
+                    flat.offset = literal.value_token->offset;
+                    flat.payload = static_cast<uint32_t>(literals.size());
+                    literals.push_back(literal.value);
+                    break;
+                }
+
+                case type_kind::Byte:
+                {
+                    auto& literal = static_cast<const literal_expression<char>&>(source);
+                    flat.offset = literal.value_token->offset;
+                    flat.payload = static_cast<uint32_t>(literals.size());
+                    literals.push_back(static_cast<unsigned char>(literal.value));
+                    break;
+                }
+
+                case type_kind::Bool:
+                {
+                    auto& literal = static_cast<const literal_expression<bool>&>(source);
+                    flat.offset = literal.value_token->offset;
+                    flat.payload = static_cast<uint32_t>(literals.size());
+                    literals.push_back(literal.value);
+                    break;
+                }
+
+                default:
+                {
+                    flat.offset = static_cast<const literal_expression<std::string_view>&>(source).value_token->offset;
+                    break;
+                }
+            }
+
+            break;
+        }
+
+        case syntax_kind::Cast:
+        {
+            set_type(static_cast<const expression_syntax&>(source).return_type);
+            break;
+        }
+
+        case syntax_kind::Not:
+        {
+            auto& expression = static_cast<const not_expression&>(source);
+            set_type(expression.return_type);
+            flat.offset = expression.not_token->offset;
+            break;
+        }
+
+        case syntax_kind::Logical:
+        {
+            auto& expression = static_cast<const logical_expression&>(source);
+            set_type(expression.return_type);
+            flat.offset = expression.oper_token->offset;
+            flat.payload = static_cast<uint32_t>(expression.oper);
+            break;
+        }
+
+        case syntax_kind::Arithmetic:
+        {
+            auto& expression = static_cast<const arithmetic_expression&>(source);
+            set_type(expression.return_type);
+            flat.offset = expression.oper_token->offset;
+            flat.payload = static_cast<uint32_t>(expression.oper);
+            break;
+        }
+
+        case syntax_kind::Relational:
+        {
+            auto& expression = static_cast<const relational_expression&>(source);
+            set_type(expression.return_type);
+            flat.offset = expression.oper_token->offset;
+            flat.payload = static_cast<uint32_t>(expression.oper);
+            break;
+        }
+
+        case syntax_kind::Conditional:
+        {
+            auto& expression = static_cast<const conditional_expression&>(source);
+            set_type(expression.return_type);
+            flat.offset = expression.if_token->offset;
+            break;
+        }
+
+        case syntax_kind::Identifier:
+        {
+            auto& expression = static_cast<const identifier_expression&>(source);
+            set_type(expression.return_type);
+            flat.offset = expression.identifier_token->offset;
+            break;
+        }
+
+        case syntax_kind::Invocation:
+        {
+            auto& expression = static_cast<const invocation_expression&>(source);
+            set_type(expression.return_type);
+            flat.offset = expression.identifier_token->offset;
+            break;
+        }
+    }
+
+    return flat;
+}
+
+size_t flat_syntax::size() const
+{
+    return nodes.size();
+}
+
+const flat_syntax::node& flat_syntax::at(uint32_t index) const
+{
+    return nodes[index];
+}
+
+type_kind flat_syntax::type_of(const node& flat) const
+{
+    return static_cast<type_kind>(flat.type);
+}
+
+std::int32_t flat_syntax::literal_of(const node& flat) const
+{
+    return literals[flat.payload];
+}
+
+size_t flat_syntax::bytes() const
+{
+    return nodes.size() * sizeof(node) + literals.size() * sizeof(std::int32_t);
+}
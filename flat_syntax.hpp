@@ -0,0 +1,62 @@
+#ifndef _FLAT_SYNTAX_HPP_
+#define _FLAT_SYNTAX_HPP_
+
+#include "abstract_syntax.hpp"
+#include "types.hpp"
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// a checked syntax tree lowered into one contiguous array of nodes, in pre-order, linked by 32-bit indices.
+// what each kind carries beyond its type and token is in payload: the operator of an operator expression, the kind of a branch,
+// or the index of a literal value. the layout holds no pointers, so it can be copied or written out as it is.
+class flat_syntax
+{
+    public:
+
+    static constexpr std::uint32_t none = UINT32_MAX;
+
+    struct node
+    {
+        syntax_kind kind;
+
+        // the type of an expression, the declared type of a declaration, parameter or function.
+        std::uint8_t type;
+
+        // source offset of the token naming the node, none when it has no token.
+        std::uint32_t offset;
+
+        std::uint32_t first_child;
+        std::uint32_t next_sibling;
+        std::uint32_t payload;
+    };
+
+    private:
+
+    std::vector<node> nodes;
+    std::vector<std::int32_t> literals;
+
+    node lower(const syntax_base& source);
+
+    public:
+
+    // lowers the tree under root without recursing, so the depth of the tree is not bound by the stack.
+    flat_syntax(const syntax_base& root);
+
+    flat_syntax(const flat_syntax& other) = delete;
+    flat_syntax& operator=(const flat_syntax& other) = delete;
+
+    std::size_t size() const;
+
+    // the root is node 0.
+    const node& at(std::uint32_t index) const;
+
+    type_kind type_of(const node& flat) const;
+
+    // the value of an int, byte or bool literal.
+    std::int32_t literal_of(const node& flat) const;
+
+    std::size_t bytes() const;
+};
+
+#endif
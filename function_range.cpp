@@ -0,0 +1,46 @@
+#include "function_range.hpp"
+
+using std::size_t;
+using std::vector;
+
+bool function_range::split(const token_buffer& tokens, vector<function_range>& functions)
+{
+    size_t depth = 0;
+    size_t first = 0;
+
+    for (size_t i = 0; i < tokens.size(); i++)
+    {
+        switch (tokens.kind(i))
+        {
+            case YYUNDEF: return false;
+
+            case END: return depth == 0 && first == i;
+
+            case LBRACE:
+            {
+                depth++;
+                break;
+            }
+
+            case RBRACE:
+            {
+                if (depth == 0)
+                {
+                    return false;
+                }
+
+                if (--depth == 0)
+                {
+                    functions.push_back({ first, tokens.offset(first), size_t(tokens.offset(i)) + tokens.length(i) });
+                    first = i + 1;
+                }
+
+                break;
+            }
+
+            default: break;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,20 @@
+#ifndef _FUNCTION_RANGE_HPP_
+#define _FUNCTION_RANGE_HPP_
+
+#include "token_buffer.hpp"
+#include <vector>
+#include <cstddef>
+
+// a top level function of the source: the index of its first token, and its text from the return type to the brace closing its body.
+struct function_range
+{
+    std::size_t first_token;
+    std::size_t begin;
+    std::size_t end;
+
+    // divides the tokens into functions at the braces that return to the top level. false when they do not divide so:
+    // after a lexical error, with unbalanced braces, or with tokens after the last function, which is left to a full parse.
+    static bool split(const token_buffer& tokens, std::vector<function_range>& functions);
+};
+
+#endif
@@ -6,8 +6,8 @@
 using std::vector;
 using std::string;
 
-type_syntax::type_syntax(syntax_token* type_token):
-    type_token(type_token), kind(types::parse(type_token->text))
+type_syntax::type_syntax(syntax_token* type_token, type_kind kind):
+    syntax_base(syntax_kind::Type), type_token(type_token), kind(kind)
 {
 }
 
@@ -21,90 +21,48 @@ bool type_syntax::is_special() const
     return types::is_special(kind);
 }
 
-type_syntax::~type_syntax()
-{
-    for (syntax_base* child : get_children())
-    {
-        delete child;
-    }
-
-    delete type_token;
-}
-
-parameter_syntax::parameter_syntax(type_syntax* type, syntax_token* identifier_token):
-    type(type), identifier_token(identifier_token), identifier(identifier_token->text)
+parameter_syntax::parameter_syntax(checker_context& context, type_syntax* type, syntax_token* identifier_token):
+    syntax_base(syntax_kind::Parameter), type(type), identifier_token(identifier_token), identifier(identifier_token->text)
 {
     if (type->kind == type_kind::Void)
     {
-        output::error_mismatch(identifier_token->position);
+        output::error_mismatch(context.line_of(identifier_token));
     }
 
-    if (symbol_table::instance().contains_symbol(identifier))
+    if (context.symtab.contains_symbol(identifier_token->id))
     {
-        output::error_def(identifier_token->position, identifier);
+        output::error_def(context.line_of(identifier_token), identifier);
     }
 
     push_back_child(type);
 }
 
-parameter_syntax::~parameter_syntax()
+function_declaration_syntax::function_declaration_syntax(type_syntax* return_type, syntax_token* identifier_token, list_syntax<parameter_syntax>* parameters, list_syntax<statement_syntax>* body, const function_symbol* declared):
+    syntax_base(syntax_kind::Function), return_type(return_type), identifier_token(identifier_token), identifier(identifier_token->text), parameters(parameters), body(body), resolved(declared)
 {
-    for (syntax_base* child : get_children())
-    {
-        delete child;
-    }
-
-    delete identifier_token;
-}
-
-function_declaration_syntax::function_declaration_syntax(type_syntax* return_type, syntax_token* identifier_token, list_syntax<parameter_syntax>* parameters, list_syntax<statement_syntax>* body):
-    return_type(return_type), identifier_token(identifier_token), identifier(identifier_token->text), parameters(parameters), body(body)
-{
-    const symbol* symbol = symbol_table::instance().get_symbol(identifier);
-
-    if (symbol == nullptr || symbol->kind != symbol_kind::Function)
-    {
-        throw std::logic_error("function should be defined.");
-    }
-
-    const function_symbol* func_symbol = static_cast<const function_symbol*>(symbol);
-
-    if (func_symbol->parameter_types.size() != parameters->size())
-    {
-        throw std::logic_error("function parameter length mismatch.");
-    }
-
-    size_t i = 0;
-    for (auto param : *parameters)
-    {
-        if (func_symbol->parameter_types[i++] != param->type->kind)
-        {
-            throw std::logic_error("function parameter type mismatch.");
-        }
-    }
-
     push_back_child(return_type);
     push_back_child(parameters);
     push_back_child(body);
 }
 
-function_declaration_syntax::~function_declaration_syntax()
+root_syntax::root_syntax(checker_context& context, list_syntax<function_declaration_syntax>* functions): syntax_base(syntax_kind::Root), functions(functions)
 {
-    for (syntax_base* child : get_children())
+    push_back_child(functions);
+
+    if (context.whole_program)
     {
-        delete child;
+        check_main(context);
     }
-
-    delete identifier_token;
 }
 
-root_syntax::root_syntax(list_syntax<function_declaration_syntax>* functions): functions(functions)
+void root_syntax::check_main(checker_context& context)
 {
-    const symbol* main_sym = symbol_table::instance().get_symbol("main");
+    const symbol* main_sym = context.symtab.get_symbol("main");
 
     if (main_sym == nullptr || main_sym->kind != symbol_kind::Function)
     {
         output::error_main_missing();
+        return;
     }
 
     const function_symbol* func_sym = static_cast<const function_symbol*>(main_sym);
@@ -113,14 +71,4 @@ root_syntax::root_syntax(list_syntax<function_declaration_syntax>* functions): f
     {
         output::error_main_missing();
     }
-
-    push_back_child(functions);
-}
-
-root_syntax::~root_syntax()
-{
-    for (syntax_base* child : get_children())
-    {
-        delete child;
-    }
 }
@@ -3,29 +3,31 @@
 
 #include "syntax_token.hpp"
 #include "abstract_syntax.hpp"
-#include <list>
+#include "checker_context.hpp"
 #include <vector>
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 template<typename element_type> class list_syntax final: public syntax_base
 {
     private:
 
-    std::list<const element_type*> elements;
+    // the elements are the children of the list.
+    std::size_t count;
 
     public:
 
-    list_syntax(): elements()
+    typedef typename syntax_range<element_type>::iterator iterator;
+
+    list_syntax(): syntax_base(syntax_kind::List), count(0)
     {
         static_assert(std::is_base_of<syntax_base, element_type>::value, "must be of type syntax_base");
     }
 
-    list_syntax(element_type* element): elements{ element }
+    list_syntax(element_type* element): list_syntax()
     {
-        static_assert(std::is_base_of<syntax_base, element_type>::value, "must be of type syntax_base");
-
-        push_back_child(element);
+        push_back(element);
     }
 
     list_syntax(const list_syntax& other) = delete;
@@ -34,39 +36,31 @@ template<typename element_type> class list_syntax final: public syntax_base
 
     list_syntax<element_type>* push_back(element_type* element)
     {
-        elements.push_back(element);
         push_back_child(element);
+        count++;
         return this;
     }
 
     list_syntax<element_type>* push_front(element_type* element)
     {
-        elements.push_front(element);
         push_front_child(element);
+        count++;
         return this;
     }
 
     std::size_t size() const
     {
-        return elements.size();
+        return count;
     }
 
-    typename std::list<const element_type*>::const_iterator begin() const
+    iterator begin() const
     {
-        return elements.begin();
+        return iterator(get_first_child());
     }
 
-    typename std::list<const element_type*>::const_iterator end() const
+    iterator end() const
     {
-        return elements.end();
-    }
-
-    ~list_syntax()
-    {
-        for (syntax_base* child : get_children())
-        {
-            delete child;
-        }
+        return iterator(nullptr);
     }
 };
 
@@ -77,8 +71,8 @@ class type_syntax final: public syntax_base
     const syntax_token* const type_token;
     const type_kind kind;
 
-    type_syntax(syntax_token* type_token);
-    ~type_syntax();
+    // the grammar knows the type from the keyword token, so its text is not parsed again.
+    type_syntax(syntax_token* type_token, type_kind kind);
 
     type_syntax(const type_syntax& other) = delete;
     type_syntax& operator=(const type_syntax& other) = delete;
@@ -93,10 +87,9 @@ class parameter_syntax final: public syntax_base
 
     const type_syntax* const type;
     const syntax_token* const identifier_token;
-    const std::string identifier;
+    const std::string_view identifier;
 
-    parameter_syntax(type_syntax* type, syntax_token* identifier_token);
-    ~parameter_syntax();
+    parameter_syntax(checker_context& context, type_syntax* type, syntax_token* identifier_token);
 
     parameter_syntax(const parameter_syntax& other) = delete;
     parameter_syntax& operator=(const parameter_syntax& other) = delete;
@@ -108,12 +101,14 @@ class function_declaration_syntax final: public syntax_base
 
     const type_syntax* const return_type;
     const syntax_token* const identifier_token;
-    const std::string identifier;
+    const std::string_view identifier;
     const list_syntax<parameter_syntax>* const parameters;
     const list_syntax<statement_syntax>* const body;
 
-    function_declaration_syntax(type_syntax* return_type, syntax_token* identifier_token, list_syntax<parameter_syntax>* parameters, list_syntax<statement_syntax>* body);
-    ~function_declaration_syntax();
+    // the function declared from the header, with its parameter types, nullptr when the name was already defined.
+    const function_symbol* const resolved;
+
+    function_declaration_syntax(type_syntax* return_type, syntax_token* identifier_token, list_syntax<parameter_syntax>* parameters, list_syntax<statement_syntax>* body, const function_symbol* declared);
 
     function_declaration_syntax(const function_declaration_syntax& other) = delete;
     function_declaration_syntax& operator=(const function_declaration_syntax& other) = delete;
@@ -125,11 +120,13 @@ class root_syntax final: public syntax_base
 
     const list_syntax<function_declaration_syntax>* const functions;
 
-    root_syntax(list_syntax<function_declaration_syntax>* functions);
-    ~root_syntax();
+    root_syntax(checker_context& context, list_syntax<function_declaration_syntax>* functions);
 
     root_syntax(const root_syntax& other) = delete;
     root_syntax& operator=(const root_syntax& other) = delete;
+
+    // reports a program without a void main(), once all of its functions are declared.
+    static void check_main(checker_context& context);
 };
 
 #endif
@@ -0,0 +1,140 @@
+#include "identifier_table.hpp"
+#include <cstring>
+
+using std::size_t;
+using std::string_view;
+using std::uint32_t;
+using std::uint64_t;
+
+static constexpr size_t initial_slots = 1024;
+static constexpr size_t padding = 8;
+
+identifier_table::identifier_table(): storage(), starts(), hashes(), slots(initial_slots, 0)
+{
+}
+
+uint64_t identifier_table::hash(string_view text)
+{
+    uint64_t value = 0x9e3779b97f4a7c15 ^ text.size();
+    size_t i = 0;
+
+    for (; i + 8 <= text.size(); i += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, text.data() + i, 8);
+        value = (value ^ word) * 0xff51afd7ed558ccd;
+        value ^= value >> 32;
+    }
+
+    if (i < text.size())
+    {
+        uint64_t word = 0;
+        std::memcpy(&word, text.data() + i, text.size() - i);
+        value = (value ^ word) * 0xc4ceb9fe1a85ec53;
+    }
+
+    return value ^ (value >> 29);
+}
+
+size_t identifier_table::probe(string_view text, uint64_t text_hash) const
+{
+    size_t mask = slots.size() - 1;
+
+    for (size_t slot = text_hash & mask;; slot = (slot + 1) & mask)
+    {
+        if (slots[slot] == 0)
+        {
+            return slot;
+        }
+
+        uint32_t id = slots[slot] - 1;
+
+        if (hashes[id] == text_hash && this->text(id) == text)
+        {
+            return slot;
+        }
+    }
+}
+
+void identifier_table::rehash(size_t slot_count)
+{
+    slots.assign(slot_count, 0);
+    size_t mask = slot_count - 1;
+
+    for (uint32_t id = 0; id < hashes.size(); id++)
+    {
+        size_t slot = hashes[id] & mask;
+
+        while (slots[slot] != 0)
+        {
+            slot = (slot + 1) & mask;
+        }
+
+        slots[slot] = id + 1;
+    }
+}
+
+uint32_t identifier_table::intern(string_view text)
+{
+    uint64_t text_hash = hash(text);
+    size_t slot = probe(text, text_hash);
+
+    if (slots[slot] != 0)
+    {
+        return slots[slot] - 1;
+    }
+
+    uint32_t id = static_cast<uint32_t>(starts.size());
+    uint32_t length = static_cast<uint32_t>(text.size());
+    size_t start = storage.size() + sizeof(length);
+
+    storage.resize(start + (text.size() + padding - 1) / padding * padding, 0);
+    std::memcpy(storage.data() + start - sizeof(length), &length, sizeof(length));
+    std::memcpy(storage.data() + start, text.data(), text.size());
+
+    starts.push_back(static_cast<uint32_t>(start));
+    hashes.push_back(text_hash);
+    slots[slot] = id + 1;
+
+    // at most half full, so probe sequences stay short.
+    if (hashes.size() * 2 > slots.size())
+    {
+        rehash(slots.size() * 2);
+    }
+
+    return id;
+}
+
+uint32_t identifier_table::find(string_view text) const
+{
+    size_t slot = probe(text, hash(text));
+    return slots[slot] != 0 ? slots[slot] - 1 : none;
+}
+
+string_view identifier_table::text(uint32_t id) const
+{
+    uint32_t length;
+    std::memcpy(&length, storage.data() + starts[id] - sizeof(length), sizeof(length));
+
+    return string_view(storage.data() + starts[id], length);
+}
+
+size_t identifier_table::size() const
+{
+    return starts.size();
+}
+
+void identifier_table::truncate(size_t count)
+{
+    if (count >= starts.size())
+    {
+        return;
+    }
+
+    storage.resize(starts[count] - sizeof(uint32_t));
+    starts.resize(count);
+    hashes.resize(count);
+
+    // removing from open addressing would break the probe sequences through the removed slots, so the kept ids are placed again.
+    rehash(slots.size());
+}
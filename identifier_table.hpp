@@ -0,0 +1,55 @@
+#ifndef _IDENTIFIER_TABLE_HPP_
+#define _IDENTIFIER_TABLE_HPP_
+
+#include <vector>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+
+// interns identifiers: each distinct text is stored once and numbered densely from 0, in the order it is first seen.
+// texts are stored one after another, each after its 32-bit length and padded to 8 bytes, so they are compared a word at a time.
+// the hash of a text is computed once, when it is interned, and kept to rule out most mismatches before comparing.
+class identifier_table
+{
+    private:
+
+    std::vector<char> storage;
+    std::vector<std::uint32_t> starts;
+    std::vector<std::uint64_t> hashes;
+
+    // open addressing over a power of two slots, each holding an id plus one, or 0 when empty.
+    std::vector<std::uint32_t> slots;
+
+    static std::uint64_t hash(std::string_view text);
+
+    // the slot holding text, or the empty slot where it would go.
+    std::size_t probe(std::string_view text, std::uint64_t text_hash) const;
+
+    // places every id again over slot_count slots.
+    void rehash(std::size_t slot_count);
+
+    public:
+
+    static constexpr std::uint32_t none = UINT32_MAX;
+
+    identifier_table();
+
+    identifier_table(const identifier_table& other) = delete;
+    identifier_table& operator=(const identifier_table& other) = delete;
+
+    // the id of text, which is added when it was not interned yet.
+    std::uint32_t intern(std::string_view text);
+
+    // the id of text, or none when it was not interned.
+    std::uint32_t find(std::string_view text) const;
+
+    // valid until the next intern.
+    std::string_view text(std::uint32_t id) const;
+
+    std::size_t size() const;
+
+    // forgets every identifier but the first count, keeping the memory for the next program.
+    void truncate(std::size_t count);
+};
+
+#endif
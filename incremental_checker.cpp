@@ -0,0 +1,343 @@
+#include "incremental_checker.hpp"
+#include "parser.tab.hpp"
+#include "checker_context.hpp"
+#include "token_buffer.hpp"
+#include "function_range.hpp"
+#include "lexer.hpp"
+#include "output.hpp"
+#include <sstream>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <cstdlib>
+
+using std::size_t;
+using std::uint64_t;
+using std::string;
+using std::string_view;
+using std::vector;
+
+namespace
+{
+    constexpr char cache_magic[8] = { 'f', 'n', 'c', 'a', 'c', 'h', 'e', '1' };
+
+    template<typename value_type>
+    void write_value(std::ostream& out, value_type value)
+    {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void write_string(std::ostream& out, const string& text)
+    {
+        write_value<uint64_t>(out, text.size());
+        out.write(text.data(), text.size());
+    }
+
+    // each read is checked against the bytes left in the file, so a damaged length is caught before anything is allocated for it.
+    template<typename value_type>
+    bool read_value(std::istream& in, uint64_t& remaining, value_type& value)
+    {
+        if (remaining < sizeof(value))
+        {
+            return false;
+        }
+
+        remaining -= sizeof(value);
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+    }
+
+    bool read_string(std::istream& in, uint64_t& remaining, string& text)
+    {
+        uint64_t size;
+
+        if (read_value(in, remaining, size) == false || size > remaining)
+        {
+            return false;
+        }
+
+        remaining -= size;
+        text.resize(size);
+        return static_cast<bool>(in.read(text.data(), size));
+    }
+
+    // a type a function can be declared with, the return type may also be void.
+    bool read_type(std::istream& in, uint64_t& remaining, type_kind& type, bool return_type)
+    {
+        std::uint8_t value;
+
+        if (read_value(in, remaining, value) == false || value >= types::type_count)
+        {
+            return false;
+        }
+
+        type = static_cast<type_kind>(value);
+        return types::is_special(type) == false || (return_type && type == type_kind::Void);
+    }
+}
+
+incremental_checker::incremental_checker(): results(), checked_functions(0)
+{
+}
+
+uint64_t incremental_checker::combine(uint64_t seed, uint64_t value)
+{
+    return seed ^ (value + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2));
+}
+
+incremental_checker::function_result incremental_checker::check_function(checker_context& context, string_view text, size_t begin, int first_line)
+{
+    function_result result;
+    result.text = text;
+    result.failed = false;
+    result.error_line = 0;
+
+    std::ostream& out = output::stream();
+    std::ostringstream buffer;
+
+    output::set_stream(buffer);
+    context.lex_range(begin, begin + text.size());
+
+    try
+    {
+        parse_program(context);
+    }
+    catch (const output::check_aborted&)
+    {
+        result.failed = true;
+    }
+    catch (const std::exception&)
+    {
+        // the check ends with this function, after what it printed, as a full check ends.
+        output::set_stream(out);
+        out << buffer.str();
+        throw;
+    }
+
+    output::set_stream(out);
+    result.output = buffer.str();
+
+    if (result.failed)
+    {
+        // the diagnostic is the last line, and within a function every diagnostic starts with "line N:".
+        size_t start = result.output.rfind('\n', result.output.size() - 2);
+        start = start == string::npos ? 0 : start + 1;
+
+        char* rest;
+        long line = std::strtol(result.output.c_str() + start + 5, &rest, 10);
+
+        result.error_line = static_cast<int>(line) - first_line;
+        result.error_rest = rest;
+        result.output.resize(start);
+
+        return result;
+    }
+
+    const function_symbol* declared = static_cast<const function_symbol*>(context.symtab.current_scope().get_symbols().back());
+
+    result.name = declared->name;
+    result.return_type = declared->type;
+    result.parameter_types = declared->parameter_types;
+
+    return result;
+}
+
+void incremental_checker::check(source_buffer& source, std::ostream& out)
+{
+    output::set_stream(out);
+    output::set_max_errors(1);
+
+    checker_context context(source, lexer_kind::Hand);
+    token_buffer tokens(source);
+    vector<function_range> functions;
+
+    lexer(source).tokenize(tokens);
+
+    checked_functions = 0;
+
+    try
+    {
+        context.open_global_scope();
+
+        // the tokens do not divide into whole functions, so the syntax error is left to a full parse to find.
+        if (function_range::split(tokens, functions) == false)
+        {
+            results.clear();
+
+            if (parse_program(context) == 0)
+            {
+                context.close_global_scope();
+            }
+
+            return;
+        }
+    }
+    catch (const output::check_aborted&)
+    {
+        return;
+    }
+
+    std::unordered_map<uint64_t, function_result> current;
+    std::hash<string_view> hash;
+
+    current.reserve(functions.size());
+    uint64_t visible = 0;
+
+    for (const symbol* sym : context.symtab.current_scope().get_symbols())
+    {
+        visible = combine(visible, hash(sym->to_string()));
+    }
+
+    context.whole_program = false;
+
+    for (const function_range& range : functions)
+    {
+        string_view text(source.data() + range.begin, range.end - range.begin);
+        uint64_t key = combine(hash(text), visible);
+        int first_line = context.line_of(range.begin);
+
+        auto found = results.find(key);
+
+        if (found != results.end() && found->second.text == text && found->second.visible == visible)
+        {
+            const function_result& result = found->second;
+
+            if (result.failed == false)
+            {
+                context.symtab.add_function(result.name, result.return_type, result.parameter_types);
+            }
+
+            current.insert(results.extract(found));
+        }
+        else
+        {
+            function_result result = check_function(context, text, range.begin, first_line);
+            result.visible = visible;
+
+            current[key] = std::move(result);
+            checked_functions++;
+        }
+
+        const function_result& result = current[key];
+
+        out << result.output;
+
+        if (result.failed)
+        {
+            out << "line " << first_line + result.error_line << result.error_rest;
+            out.flush();
+
+            // the functions after the error were not reached, their results stay for when it is fixed.
+            results.merge(current);
+            return;
+        }
+
+        visible = combine(visible, hash(context.symtab.current_scope().get_symbols().back()->to_string()));
+    }
+
+    results.swap(current);
+    context.whole_program = true;
+
+    try
+    {
+        root_syntax::check_main(context);
+        context.close_global_scope();
+    }
+    catch (const output::check_aborted&)
+    {
+    }
+}
+
+size_t incremental_checker::last_checked() const
+{
+    return checked_functions;
+}
+
+bool incremental_checker::load(const char* path)
+{
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    std::streamoff size = in.tellg();
+
+    in.seekg(0);
+
+    if (in.fail() || size < 0)
+    {
+        return false;
+    }
+
+    uint64_t remaining = static_cast<uint64_t>(size);
+    char magic[sizeof(cache_magic)];
+    uint64_t count;
+
+    if (read_value(in, remaining, magic) == false || string_view(magic, sizeof(magic)) != string_view(cache_magic, sizeof(cache_magic)) || read_value(in, remaining, count) == false)
+    {
+        return false;
+    }
+
+    // a cache that does not hold exactly what save wrote is ignored as a whole, every function is then checked again.
+    std::unordered_map<uint64_t, function_result> loaded;
+
+    for (uint64_t i = 0; i < count; i++)
+    {
+        uint64_t key;
+        function_result result;
+        std::uint8_t failed;
+        uint64_t parameter_count;
+
+        bool complete = read_value(in, remaining, key) && read_string(in, remaining, result.text) && read_value(in, remaining, result.visible)
+            && read_string(in, remaining, result.output) && read_value(in, remaining, failed) && failed <= 1 && read_value(in, remaining, result.error_line)
+            && read_string(in, remaining, result.error_rest) && read_string(in, remaining, result.name) && read_type(in, remaining, result.return_type, true)
+            && read_value(in, remaining, parameter_count) && parameter_count <= remaining;
+
+        for (uint64_t j = 0; complete && j < parameter_count; j++)
+        {
+            type_kind type;
+            complete = read_type(in, remaining, type, false);
+            result.parameter_types.push_back(type);
+        }
+
+        if (complete == false)
+        {
+            return false;
+        }
+
+        result.failed = failed != 0;
+        loaded[key] = std::move(result);
+    }
+
+    if (remaining != 0)
+    {
+        return false;
+    }
+
+    results.swap(loaded);
+    return true;
+}
+
+bool incremental_checker::save(const char* path) const
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+
+    out.write(cache_magic, sizeof(cache_magic));
+    write_value<uint64_t>(out, results.size());
+
+    for (const auto& [key, result] : results)
+    {
+        write_value(out, key);
+        write_string(out, result.text);
+        write_value(out, result.visible);
+        write_string(out, result.output);
+        write_value<std::uint8_t>(out, result.failed);
+        write_value(out, result.error_line);
+        write_string(out, result.error_rest);
+        write_string(out, result.name);
+        write_value(out, static_cast<std::uint8_t>(result.return_type));
+        write_value<uint64_t>(out, result.parameter_types.size());
+
+        for (type_kind type : result.parameter_types)
+        {
+            write_value(out, static_cast<std::uint8_t>(type));
+        }
+    }
+
+    return static_cast<bool>(out.flush());
+}
@@ -0,0 +1,69 @@
+#ifndef _INCREMENTAL_CHECKER_HPP_
+#define _INCREMENTAL_CHECKER_HPP_
+
+#include "source_buffer.hpp"
+#include "types.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <ostream>
+#include <cstddef>
+#include <cstdint>
+
+class checker_context;
+
+// checks successive versions of a program, re-checking only the functions that changed since the previous version.
+// what a function prints depends on its own text and on the signatures declared before it, so results are kept under a fingerprint of both.
+// diagnostic lines are kept relative to the first line of the function, so a function that only moved is not re-checked.
+// only the first diagnostic is reported, with recovery a syntax error may span functions.
+class incremental_checker
+{
+    private:
+
+    struct function_result
+    {
+        // compared on lookup, so a fingerprint collision cannot return the result of another function.
+        std::string text;
+        std::uint64_t visible;
+
+        // scope dumps, and the diagnostic that ended the check without its line number.
+        std::string output;
+        bool failed;
+        int error_line;
+        std::string error_rest;
+
+        // the declared function, added to the global scope when the result is reused.
+        std::string name;
+        type_kind return_type;
+        std::vector<type_kind> parameter_types;
+    };
+
+    std::unordered_map<std::uint64_t, function_result> results;
+    std::size_t checked_functions;
+
+    static std::uint64_t combine(std::uint64_t seed, std::uint64_t value);
+
+    // parses and checks a single function, with every function before it already in the global scope.
+    static function_result check_function(checker_context& context, std::string_view text, std::size_t begin, int first_line);
+
+    public:
+
+    incremental_checker();
+
+    incremental_checker(const incremental_checker& other) = delete;
+    incremental_checker& operator=(const incremental_checker& other) = delete;
+
+    // checks source, writing to out exactly what a full check writes. an exception that ends the check is thrown as the full check throws it.
+    void check(source_buffer& source, std::ostream& out);
+
+    // functions parsed and checked by the last check, the others reused their results.
+    std::size_t last_checked() const;
+
+    // results kept by an earlier process, false when path holds none or its contents are not what save wrote, which then count as misses.
+    bool load(const char* path);
+
+    bool save(const char* path) const;
+};
+
+#endif
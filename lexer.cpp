@@ -0,0 +1,305 @@
+#include "lexer.hpp"
+#include "syntax_token.hpp"
+#include <string_view>
+#include <cstddef>
+
+using std::string_view;
+using std::size_t;
+
+namespace
+{
+    struct keyword
+    {
+        string_view text;
+        yytoken_kind_t kind;
+    };
+
+    constexpr keyword keywords[] =
+    {
+        { "void", VOID }, { "int", INT }, { "byte", BYTE }, { "b", B }, { "bool", BOOL },
+        { "and", AND }, { "or", OR }, { "not", NOT }, { "true", TRUE }, { "false", FALSE },
+        { "return", RETURN }, { "if", IF }, { "else", ELSE }, { "while", WHILE },
+        { "break", BREAK }, { "continue", CONTINUE },
+    };
+
+    constexpr size_t keyword_slots = 32;
+
+    constexpr size_t keyword_hash(string_view text)
+    {
+        return (static_cast<size_t>(text.front()) + static_cast<size_t>(text.back())) % keyword_slots;
+    }
+
+    struct keyword_table
+    {
+        keyword slots[keyword_slots];
+    };
+
+    constexpr keyword_table build_keyword_table()
+    {
+        keyword_table table{};
+
+        for (const keyword& kw : keywords)
+        {
+            table.slots[keyword_hash(kw.text)] = kw;
+        }
+
+        return table;
+    }
+
+    constexpr bool is_perfect_hash()
+    {
+        keyword_table table = build_keyword_table();
+
+        for (const keyword& kw : keywords)
+        {
+            if (table.slots[keyword_hash(kw.text)].text != kw.text)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static_assert(is_perfect_hash(), "keyword hash has collisions");
+
+    constexpr keyword_table keyword_lookup = build_keyword_table();
+
+    // characters of a name checked one at a time before the index scans the rest.
+    constexpr size_t short_word = 8;
+
+    inline bool is_letter(char c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    }
+
+    inline bool is_digit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    inline bool is_whitespace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    inline bool is_escapable(char c)
+    {
+        return c == 'r' || c == 'n' || c == 't' || c == '"' || c == '\\';
+    }
+}
+
+lexer::lexer(const source_buffer& source): lexer(source.data(), source.data() + source.size(), 0, true)
+{
+}
+
+lexer::lexer(const char* begin, const char* end, size_t base, bool finished):
+    begin(begin), current(begin), end(end), token_start(begin), base(base), finished(finished)
+{
+}
+
+yytoken_kind_t lexer::next(YYSTYPE* value, syntax_arena& arena)
+{
+    const char* resume = current;
+    yytoken_kind_t kind = scan();
+
+    if (current == end && finished == false)
+    {
+        current = resume;
+        return YYEMPTY;
+    }
+
+    if (token_buffer::carries_text(kind))
+    {
+        value->token = new (arena) syntax_token(kind, last_offset(), string_view(token_start, current - token_start));
+    }
+
+    return kind;
+}
+
+size_t lexer::last_offset() const
+{
+    return base + (token_start - begin);
+}
+
+const char* lexer::position() const
+{
+    return current;
+}
+
+void lexer::extend(const char* new_end)
+{
+    end = new_end;
+}
+
+void lexer::finish()
+{
+    finished = true;
+}
+
+void lexer::tokenize(token_buffer& tokens)
+{
+    yytoken_kind_t kind;
+
+    do
+    {
+        kind = scan();
+        tokens.push_back(kind, last_offset(), current - token_start);
+    }
+    while (kind != END);
+}
+
+yytoken_kind_t lexer::scan()
+{
+    // whitespace and comments, a comment swallows at most one trailing line break.
+    while (true)
+    {
+        if (is_whitespace(*current))
+        {
+            current = source_index::skip_whitespace(begin, end, current + 1);
+        }
+
+        if (current == end || current[0] != '/' || current[1] != '/')
+        {
+            break;
+        }
+
+        current = source_index::find_line_break(begin, end, current + 2);
+
+        if (current != end)
+        {
+            current++;
+        }
+    }
+
+    token_start = current;
+
+    if (current == end)
+    {
+        return END;
+    }
+
+    char c = *current++;
+
+    if (is_letter(c))
+    {
+        // most names are a few characters, the index only takes over from a long one. the NUL padding stops the loop.
+        const char* short_end = current + short_word;
+
+        while (current != short_end && (is_letter(*current) || is_digit(*current)))
+        {
+            current++;
+        }
+
+        if (current == short_end && (is_letter(*current) || is_digit(*current)))
+        {
+            current = source_index::skip_word(begin, end, current + 1);
+        }
+
+        string_view text(token_start, current - token_start);
+        const keyword& kw = keyword_lookup.slots[keyword_hash(text)];
+
+        return kw.text == text ? kw.kind : ID;
+    }
+
+    if (is_digit(c))
+    {
+        if (c != '0')
+        {
+            while (is_digit(*current))
+            {
+                current++;
+            }
+        }
+
+        return NUM;
+    }
+
+    switch (c)
+    {
+        case ';': return SC;
+        case ',': return COMMA;
+        case '(': return LPAREN;
+        case ')': return RPAREN;
+        case '{': return LBRACE;
+        case '}': return RBRACE;
+        case '+': return ADDOP;
+        case '-': return ADDOP;
+        case '*': return MULOP;
+        case '/': return MULOP;
+
+        case '=':
+        {
+            if (*current == '=')
+            {
+                current++;
+                return EQOP;
+            }
+
+            return ASSIGN;
+        }
+
+        case '!':
+        {
+            if (*current == '=')
+            {
+                current++;
+                return EQOP;
+            }
+
+            break;
+        }
+
+        case '<':
+        case '>':
+        {
+            if (*current == '=')
+            {
+                current++;
+            }
+
+            return RELOP;
+        }
+
+        case '"':
+        {
+            while (true)
+            {
+                current = source_index::find_string_stop(begin, end, current);
+
+                if (current == end || *current != '\\' || is_escapable(current[1]) == false)
+                {
+                    break;
+                }
+
+                current += 2;
+            }
+
+            // a backslash that ends the text may still be followed by its escaped character.
+            if (current + 1 == end && *current == '\\')
+            {
+                current = end;
+            }
+
+            // an empty or unterminated literal is not a string, so flex falls back to the catch-all rule.
+            if (current != end && *current == '"' && current != token_start + 1)
+            {
+                current++;
+                return STRING;
+            }
+
+            // the catch-all rule takes the quote alone, and lexing resumes right after it.
+            // streamed text that ends inside the literal may still complete it, so the scan is left at the end to be retried.
+            if (current != end || finished)
+            {
+                current = token_start + 1;
+            }
+
+            break;
+        }
+
+        default: break;
+    }
+
+    return YYUNDEF;
+}
@@ -0,0 +1,55 @@
+#ifndef _LEXER_HPP_
+#define _LEXER_HPP_
+
+#include "parser.tab.hpp"
+#include "source_buffer.hpp"
+#include "source_index.hpp"
+#include "token_buffer.hpp"
+#include <cstddef>
+
+// hand-written alternative to scanner.lex, producing the same tokens and line numbers.
+// the text may also arrive in pieces: until finish is called, a token that reaches the end of the text may continue,
+// so next returns YYEMPTY instead and lexes it again once the text is extended.
+class lexer
+{
+    private:
+
+    const char* const begin;
+    const char* current;
+    const char* end;
+    const char* token_start;
+    const std::size_t base;
+    bool finished;
+
+    // kind of the next token, which spans [token_start, current). YYUNDEF marks a lexical error.
+    yytoken_kind_t scan();
+
+    public:
+
+    lexer(const source_buffer& source);
+
+    // lexes [begin, end), which must be padded like source_buffer. offsets count from base at begin.
+    lexer(const char* begin, const char* end, std::size_t base, bool finished);
+
+    lexer(const lexer& other) = delete;
+    lexer& operator=(const lexer& other) = delete;
+
+    // tokens that carry text are allocated from arena.
+    yytoken_kind_t next(YYSTYPE* value, syntax_arena& arena);
+
+    std::size_t last_offset() const;
+
+    // position of the first character not lexed yet.
+    const char* position() const;
+
+    // more text was written at the end.
+    void extend(const char* new_end);
+
+    // no more text will follow.
+    void finish();
+
+    // lexes the whole source into tokens, ending with END. lexical errors are kept as YYUNDEF tokens.
+    void tokenize(token_buffer& tokens);
+};
+
+#endif
@@ -0,0 +1,142 @@
+#include "load_generator.hpp"
+#include "socket_frames.hpp"
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <iomanip>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using std::size_t;
+using std::string;
+using std::vector;
+
+using load_clock = std::chrono::steady_clock;
+
+load_generator::load_generator(const char* path, string program, size_t clients, size_t requests):
+    path(path), program(std::move(program)), clients(std::max<size_t>(clients, 1)), requests(requests)
+{
+}
+
+int load_generator::connect_server() const
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        return -1;
+    }
+
+    std::memcpy(address.sun_path, path.data(), path.size());
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    if (fd >= 0 && connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+bool load_generator::run(std::ostream& report) const
+{
+    // the first answer, from an untimed request, is what every other one is compared to.
+    string expected;
+    int fd = connect_server();
+
+    if (fd < 0 || socket_frames::write(fd, program) == false || socket_frames::read(fd, expected) == false)
+    {
+        report << "cannot reach server at " << path << std::endl;
+
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+
+        return false;
+    }
+
+    close(fd);
+
+    vector<vector<double>> latencies(clients);
+    std::atomic<size_t> mismatches(0);
+    std::atomic<bool> broken(false);
+    vector<std::thread> threads;
+
+    load_clock::time_point start = load_clock::now();
+
+    for (size_t client = 0; client < clients; client++)
+    {
+        // the requests are spread evenly, the first ones take the remainder.
+        size_t count = requests / clients + (client < requests % clients ? 1 : 0);
+
+        threads.emplace_back([&, client, count]()
+        {
+            int fd = connect_server();
+            string answer;
+
+            for (size_t i = 0; i < count && fd >= 0; i++)
+            {
+                load_clock::time_point sent = load_clock::now();
+
+                if (socket_frames::write(fd, program) == false || socket_frames::read(fd, answer) == false)
+                {
+                    break;
+                }
+
+                latencies[client].push_back(std::chrono::duration<double, std::micro>(load_clock::now() - sent).count());
+
+                if (answer != expected)
+                {
+                    mismatches++;
+                }
+            }
+
+            if (latencies[client].size() != count)
+            {
+                broken = true;
+            }
+
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    double seconds = std::chrono::duration<double>(load_clock::now() - start).count();
+    vector<double> all;
+
+    for (const vector<double>& client : latencies)
+    {
+        all.insert(all.end(), client.begin(), client.end());
+    }
+
+    std::sort(all.begin(), all.end());
+
+    auto percentile = [&](double fraction)
+    {
+        return all.empty() ? 0.0 : all[std::min(all.size() - 1, static_cast<size_t>(fraction * all.size()))];
+    };
+
+    report << std::fixed << std::setprecision(1);
+    report << "requests:   " << all.size() << " over " << clients << " connections" << std::endl;
+    report << "p50:        " << percentile(0.50) << " us" << std::endl;
+    report << "p99:        " << percentile(0.99) << " us" << std::endl;
+    report << "throughput: " << (seconds > 0 ? all.size() / seconds : 0.0) << " requests/s" << std::endl;
+    report << "mismatches: " << mismatches << std::endl;
+
+    return broken == false;
+}
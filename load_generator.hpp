@@ -0,0 +1,33 @@
+#ifndef _LOAD_GENERATOR_HPP_
+#define _LOAD_GENERATOR_HPP_
+
+#include <string>
+#include <ostream>
+#include <cstddef>
+
+// sends one program to a check_server over a number of connections, each waiting for every answer before sending again.
+// reports the latency percentiles and the throughput, and how many answers differed from the first one.
+class load_generator
+{
+    private:
+
+    const std::string path;
+    const std::string program;
+    const std::size_t clients;
+    const std::size_t requests;
+
+    // connects to the server, -1 when it cannot.
+    int connect_server() const;
+
+    public:
+
+    load_generator(const char* path, std::string program, std::size_t clients, std::size_t requests);
+
+    load_generator(const load_generator& other) = delete;
+    load_generator& operator=(const load_generator& other) = delete;
+
+    // false when the server could not be reached or a connection broke.
+    bool run(std::ostream& report) const;
+};
+
+#endif
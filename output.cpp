@@ -2,15 +2,49 @@
 #include "output.hpp"
 #include <sstream>
 #include <string>
-#include <stdlib.h>
+#include <string_view>
 
 using namespace std;
 
 string type_list_to_string(const std::vector<string>& arg_types);
 
+// each thread checks one program at a time, so the target stream and the diagnostic count are per thread.
+static thread_local ostream* target = &cout;
+static thread_local size_t error_limit = 1;
+static thread_local size_t reported_errors = 0;
+
+static void report()
+{
+    if (++reported_errors >= error_limit)
+    {
+        throw output::check_aborted();
+    }
+}
+
+ostream& output::stream()
+{
+    return *target;
+}
+
+void output::set_stream(ostream& stream)
+{
+    target = &stream;
+}
+
+void output::set_max_errors(size_t max_errors)
+{
+    error_limit = max_errors;
+    reported_errors = 0;
+}
+
+size_t output::error_count()
+{
+    return reported_errors;
+}
+
 void output::end_scope()
 {
-    cout << "---end scope---" << endl;
+    stream() << "---end scope---" << endl;
 }
 
 string type_list_to_string(const std::vector<string>& arg_types)
@@ -29,66 +63,66 @@ string type_list_to_string(const std::vector<string>& arg_types)
 
 void output::error_lex(int lineno)
 {
-    cout << "line " << lineno << ":" << " lexical error" << endl;
-    exit(0);
+    stream() << "line " << lineno << ":" << " lexical error" << endl;
+    report();
 }
 
 void output::error_syn(int lineno)
 {
-    cout << "line " << lineno << ":" << " syntax error" << endl;
-    exit(0);
+    stream() << "line " << lineno << ":" << " syntax error" << endl;
+    report();
 }
 
-void output::error_undef(int lineno, const string& id)
+void output::error_undef(int lineno, string_view id)
 {
-    cout << "line " << lineno << ":" << " variable " << id << " is not defined" << endl;
-    exit(0);
+    stream() << "line " << lineno << ":" << " variable " << id << " is not defined" << endl;
+    report();
 }
 
-void output::error_def(int lineno, const string& id)
+void output::error_def(int lineno, string_view id)
 {
-    cout << "line " << lineno << ":" << " identifier " << id << " is already defined" << endl;
-    exit(0);
+    stream() << "line " << lineno << ":" << " identifier " << id << " is already defined" << endl;
+    report();
 }
 
-void output::error_undef_func(int lineno, const string& id)
+void output::error_undef_func(int lineno, string_view id)
 {
-    cout << "line " << lineno << ":" << " function " << id << " is not defined" << endl;
-    exit(0);
+    stream() << "line " << lineno << ":" << " function " << id << " is not defined" << endl;
+    report();
 }
 
 void output::error_mismatch(int lineno)
 {
-    cout << "line " << lineno << ":" << " type mismatch" << endl;
-    exit(0);
+    stream() << "line " << lineno << ":" << " type mismatch" << endl;
+    report();
 }
 
-void output::error_prototype_mismatch(int lineno, const string& id, std::vector<string>& arg_types)
+void output::error_prototype_mismatch(int lineno, string_view id, std::vector<string>& arg_types)
 {
-    cout << "line " << lineno << ": prototype mismatch, function " << id << " expects arguments " << type_list_to_string(arg_types) << endl;
-    exit(0);
+    stream() << "line " << lineno << ": prototype mismatch, function " << id << " expects arguments " << type_list_to_string(arg_types) << endl;
+    report();
 }
 
 void output::error_unexpected_break(int lineno)
 {
-    cout << "line " << lineno << ":" << " unexpected break statement" << endl;
-    exit(0);
+    stream() << "line " << lineno << ":" << " unexpected break statement" << endl;
+    report();
 }
 
 void output::error_unexpected_continue(int lineno)
 {
-    cout << "line " << lineno << ":" << " unexpected continue statement" << endl;
-    exit(0);
+    stream() << "line " << lineno << ":" << " unexpected continue statement" << endl;
+    report();
 }
 
 void output::error_main_missing()
 {
-    cout << "Program has no 'void main()' function" << endl;
-    exit(0);
+    stream() << "Program has no 'void main()' function" << endl;
+    report();
 }
 
-void output::error_byte_too_large(int lineno, const string& value)
+void output::error_byte_too_large(int lineno, string_view value)
 {
-    cout << "line " << lineno << ": byte value " << value << " out of range" << endl;
-    exit(0);
+    stream() << "line " << lineno << ": byte value " << value << " out of range" << endl;
+    report();
 }
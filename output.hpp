@@ -3,32 +3,49 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
+#include <ostream>
+#include <cstddef>
 
 namespace output
 {
+    // thrown once the diagnostic limit is reached, it ends the check of the current program only.
+    struct check_aborted {};
+
+    // stream the calling thread writes scope dumps and diagnostics to, std::cout until set otherwise.
+    std::ostream& stream();
+
+    void set_stream(std::ostream& stream);
+
+    // number of diagnostics the calling thread reports before its check is aborted, 1 unless set otherwise.
+    // also resets the count of reported diagnostics.
+    void set_max_errors(std::size_t max_errors);
+
+    std::size_t error_count();
+
     void end_scope();
 
-    [[noreturn]] void error_lex(int lineno);
+    void error_lex(int lineno);
 
-    [[noreturn]] void error_syn(int lineno);
+    void error_syn(int lineno);
 
-    [[noreturn]] void error_undef(int lineno, const std::string& id);
+    void error_undef(int lineno, std::string_view id);
 
-    [[noreturn]] void error_def(int lineno, const std::string& id);
+    void error_def(int lineno, std::string_view id);
 
-    [[noreturn]] void error_undef_func(int lineno, const std::string& id);
+    void error_undef_func(int lineno, std::string_view id);
 
-    [[noreturn]] void error_mismatch(int lineno);
+    void error_mismatch(int lineno);
 
-    [[noreturn]] void error_prototype_mismatch(int lineno, const std::string& id, std::vector<std::string>& arg_types);
+    void error_prototype_mismatch(int lineno, std::string_view id, std::vector<std::string>& arg_types);
 
-    [[noreturn]] void error_unexpected_break(int lineno);
+    void error_unexpected_break(int lineno);
 
-    [[noreturn]] void error_unexpected_continue(int lineno);
+    void error_unexpected_continue(int lineno);
 
-    [[noreturn]] void error_main_missing();
+    void error_main_missing();
 
-    [[noreturn]] void error_byte_too_large(int lineno, const std::string& value);
+    void error_byte_too_large(int lineno, std::string_view value);
 }
 
 #endif
\ No newline at end of file
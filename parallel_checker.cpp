@@ -0,0 +1,230 @@
+#include "parallel_checker.hpp"
+#include "parser.tab.hpp"
+#include "lexer.hpp"
+#include "output.hpp"
+#include "types.hpp"
+#include <sstream>
+#include <exception>
+#include <memory>
+#include <atomic>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using std::size_t;
+using std::string;
+using std::string_view;
+using std::vector;
+
+// the type a keyword names, Invalid for any other token.
+static type_kind type_of(yytoken_kind_t kind)
+{
+    switch (kind)
+    {
+        case INT: return type_kind::Int;
+        case BYTE: return type_kind::Byte;
+        case BOOL: return type_kind::Bool;
+        case VOID: return type_kind::Void;
+
+        default: return type_kind::Invalid;
+    }
+}
+
+// checks what is left of the source sequentially, which for a check that is not split is all of it.
+static void check_sequential(checker_context& context)
+{
+    try
+    {
+        if (parse_program(context) == 0)
+        {
+            context.close_global_scope();
+        }
+    }
+    catch (const output::check_aborted&)
+    {
+    }
+}
+
+parallel_checker::parallel_checker(size_t thread_count): pool(thread_count)
+{
+}
+
+bool parallel_checker::declare(checker_context& context, const source_buffer& source, const token_buffer& tokens, const function_range& function)
+{
+    auto text = [&](size_t i) { return string_view(source.data() + tokens.offset(i), tokens.length(i)); };
+
+    size_t i = function.first_token;
+
+    type_kind return_type = type_of(tokens.kind(i));
+
+    if (return_type == type_kind::Invalid || tokens.kind(i + 1) != ID || tokens.kind(i + 2) != LPAREN)
+    {
+        return false;
+    }
+
+    string_view name = text(i + 1);
+    vector<type_kind> parameter_types;
+
+    i += 3;
+
+    while (tokens.kind(i) != RPAREN)
+    {
+        type_kind parameter_type = type_of(tokens.kind(i));
+
+        // a void parameter is left to the sequential check, which reports it.
+        if (parameter_type == type_kind::Invalid || parameter_type == type_kind::Void || tokens.kind(i + 1) != ID)
+        {
+            return false;
+        }
+
+        parameter_types.push_back(parameter_type);
+        i += 2;
+
+        if (tokens.kind(i) == COMMA && tokens.kind(i + 1) != RPAREN)
+        {
+            i++;
+        }
+        else if (tokens.kind(i) != RPAREN)
+        {
+            return false;
+        }
+    }
+
+    return tokens.kind(i + 1) == LBRACE && context.symtab.add_function(name, return_type, parameter_types);
+}
+
+void parallel_checker::check(source_buffer& source, const check_options& options, std::ostream& out)
+{
+    output::set_stream(out);
+    output::set_max_errors(options.max_errors);
+
+    // flex lexes as the parser asks for tokens, so there are none to split the source by beforehand.
+    if (options.lexer == lexer_kind::Flex)
+    {
+        checker_context context(source, lexer_kind::Flex);
+
+        context.keep_functions = options.check_only == false;
+        context.open_global_scope();
+        check_sequential(context);
+        return;
+    }
+
+    // the hand lexer and the token buffer lex alike, so either way the source is indexed and lexed once, here,
+    // and every worker reads its function's range of those tokens.
+    source_index index(source);
+    token_buffer tokens(source);
+
+    lexer(source).tokenize(tokens);
+
+    checker_context context(source, index, tokens);
+    vector<function_range> functions;
+
+    context.keep_functions = options.check_only == false;
+    context.open_global_scope();
+
+    // with recovery a syntax error may carry over into the next function, so only a check that stops at the first diagnostic is split.
+    if (options.max_errors != 1 || function_range::split(tokens, functions) == false)
+    {
+        check_sequential(context);
+        return;
+    }
+
+    // phase one: the global scope as the sequential check leaves it, up to the first function it cannot declare.
+    const scope& globals = context.symtab.current_scope();
+    size_t builtins = globals.get_symbols().size();
+    size_t declared = 0;
+
+    while (declared < functions.size() && declare(context, source, tokens, functions[declared]))
+    {
+        declared++;
+    }
+
+    // phase two: the declared functions, each parsed and checked by a worker against the globals declared before it.
+    struct function_result
+    {
+        std::string output;
+        bool failed = false;
+        std::exception_ptr failure;
+    };
+
+    vector<function_result> results(declared);
+    vector<std::unique_ptr<checker_context>> workers(pool.size());
+    vector<size_t> order(declared);
+    std::atomic<size_t> first_failed(declared);
+
+    std::iota(order.begin(), order.end(), 0);
+
+    pool.run(order, [&](size_t worker, size_t i)
+    {
+        // nothing after the first diagnostic is printed.
+        if (i > first_failed)
+        {
+            return;
+        }
+
+        if (workers[worker] == nullptr)
+        {
+            workers[worker].reset(new checker_context(source, index, tokens));
+            workers[worker]->whole_program = false;
+            workers[worker]->keep_functions = options.check_only == false;
+        }
+
+        checker_context& worker_context = *workers[worker];
+        std::ostringstream buffer;
+
+        output::set_stream(buffer);
+        output::set_max_errors(1);
+
+        worker_context.symtab.share_globals(context.symtab, builtins + i);
+        // the functions follow one another, so the next one's first token is the one after this one's closing brace.
+        size_t last = i + 1 < functions.size() ? functions[i + 1].first_token : tokens.size() - 1;
+
+        worker_context.lex_tokens(functions[i].first_token, last, functions[i].end);
+
+        try
+        {
+            parse_program(worker_context);
+        }
+        catch (const output::check_aborted&)
+        {
+            results[i].failed = true;
+        }
+        catch (const std::exception&)
+        {
+            results[i].failed = true;
+            results[i].failure = std::current_exception();
+        }
+
+        for (size_t current = first_failed; results[i].failed && i < current && first_failed.compare_exchange_weak(current, i) == false;)
+        {
+        }
+
+        results[i].output = buffer.str();
+    });
+
+    // the calling thread is one of the workers.
+    output::set_stream(out);
+    output::set_max_errors(options.max_errors);
+
+    for (const function_result& result : results)
+    {
+        out << result.output;
+
+        if (result.failure != nullptr)
+        {
+            std::rethrow_exception(result.failure);
+        }
+
+        if (result.failed)
+        {
+            return;
+        }
+    }
+
+    // the functions left undeclared, and the check for main, follow sequentially.
+    size_t rest = declared < functions.size() ? functions[declared].first_token : tokens.size() - 1;
+
+    context.lex_tokens(rest, tokens.size() - 1, source.size());
+    check_sequential(context);
+}
@@ -0,0 +1,39 @@
+#ifndef _PARALLEL_CHECKER_HPP_
+#define _PARALLEL_CHECKER_HPP_
+
+#include "checker_context.hpp"
+#include "source_buffer.hpp"
+#include "token_buffer.hpp"
+#include "function_range.hpp"
+#include "work_pool.hpp"
+#include <ostream>
+#include <cstddef>
+
+// checks the bodies of a program's functions concurrently, in two phases.
+// first every function is declared in the global scope from its header, in source order. then the functions are parsed and
+// checked on a work_pool, each against the global symbols declared before it, and their output is written in source order
+// up to and including the first diagnostic, which is what a sequential check prints.
+class parallel_checker
+{
+    private:
+
+    work_pool pool;
+
+    // declares the function from its header tokens, false when the header is not a plain one or redefines a name.
+    // the check of such a function, and of every one after it, is left to the sequential parse.
+    static bool declare(checker_context& context, const source_buffer& source, const token_buffer& tokens, const function_range& function);
+
+    public:
+
+    // a thread count of 0 sizes the pool to the machine.
+    parallel_checker(std::size_t thread_count = 0);
+
+    parallel_checker(const parallel_checker& other) = delete;
+    parallel_checker& operator=(const parallel_checker& other) = delete;
+
+    // checks source, writing to out exactly what a sequential check writes. with recovery, or with flex, the check is a sequential one.
+    // an exception that ends the check of a function is thrown once everything before it is written, as the sequential check throws it.
+    void check(source_buffer& source, const check_options& options, std::ostream& out);
+};
+
+#endif
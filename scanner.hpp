@@ -0,0 +1,16 @@
+#ifndef _SCANNER_HPP_
+#define _SCANNER_HPP_
+
+#include "parser.tab.hpp"
+#include "checker_context.hpp"
+#include "source_buffer.hpp"
+
+// entry points of the reentrant flex scanner generated from scanner.lex.
+
+void* create_scanner(checker_context& context, source_buffer& source);
+
+void destroy_scanner(void* scanner);
+
+int flex_lex(YYSTYPE* yylval_param, void* yyscanner);
+
+#endif
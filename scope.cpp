@@ -1,88 +1,69 @@
 #include "scope.hpp"
-#include <vector>
-#include <string>
-#include <stdexcept>
-#include <algorithm>
+#include "symbol_table.hpp"
 
-using std::string;
-using std::vector;
-using std::list;
+using std::size_t;
+using std::uint32_t;
 
-scope::scope(int offset, bool loop_scope):
-    symbol_list(), symbol_map(), offset(offset), param_offset(offset - 1), loop_scope(loop_scope)
+symbol_range::symbol_range(const symbol* const* first, const symbol* const* last): first(first), last(last)
 {
 }
 
-scope::~scope()
+const symbol* const* symbol_range::begin() const
 {
-    for (const symbol* sym : symbol_list)
-    {
-        delete sym;
-    }
+    return first;
 }
 
-bool scope::contains_symbol(const string& name) const
+const symbol* const* symbol_range::end() const
 {
-    return symbol_map.find(name) != symbol_map.end();
+    return last;
 }
 
-const symbol* scope::get_symbol(const string& name) const
+size_t symbol_range::size() const
 {
-    if (contains_symbol(name) == false)
-    {
-        return nullptr;
-    }
-
-    return symbol_map.at(name);
+    return last - first;
 }
 
-const list<const symbol*>& scope::get_symbols() const
+const symbol* symbol_range::back() const
 {
-    return symbol_list;
+    return *(last - 1);
 }
 
-bool scope::add_variable(const string& name, type_kind type)
+scope::scope(const symbol_table& table, size_t first, int offset, size_t loop_depth, bool loop_scope):
+    table(&table), first(first), last(first), offset(offset), param_offset(offset - 1), loop_depth(loop_depth + (loop_scope ? 1 : 0)), loop_scope(loop_scope)
 {
-    if (contains_symbol(name))
-    {
-        return false;
-    }
-
-    symbol* new_symbol = new variable_symbol(name, type, offset);
-    symbol_list.push_back(new_symbol);
-    symbol_map[name] = new_symbol;
-
-    offset += 1;
-
-    return true;
 }
 
-bool scope::add_parameter(const string& name, type_kind type)
+uint32_t scope::index_of(uint32_t id) const
 {
-    if (contains_symbol(name))
+    // the symbols with the same name, from the innermost out. names are declared again only in erroneous programs.
+    for (uint32_t index = table->innermost[id]; index != none && index >= first; index = table->shadowed[index])
     {
-        return false;
+        if (index < last)
+        {
+            return index;
+        }
     }
 
-    symbol* new_symbol = new variable_symbol(name, type, param_offset);
-    symbol_list.push_back(new_symbol);
-    symbol_map[name] = new_symbol;
-
-    param_offset -= 1;
+    return none;
+}
 
-    return true;
+bool scope::contains_symbol(uint32_t id) const
+{
+    return index_of(id) != none;
 }
 
-bool scope::add_function(const string& name, type_kind return_type, const vector<type_kind>& parameter_types)
+const symbol* scope::get_symbol(uint32_t id) const
 {
-    if (contains_symbol(name))
-    {
-        return false;
-    }
+    uint32_t index = index_of(id);
+    return index != none ? table->symbols[index] : nullptr;
+}
 
-    symbol* new_symbol = new function_symbol(name, return_type, parameter_types);
-    symbol_list.push_back(new_symbol);
-    symbol_map[name] = new_symbol;
+size_t scope::position_of(uint32_t id) const
+{
+    return index_of(id) - first;
+}
 
-    return true;
+symbol_range scope::get_symbols() const
+{
+    return symbol_range(table->symbols.data() + first, table->symbols.data() + last);
 }
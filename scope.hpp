@@ -1,42 +1,71 @@
 #ifndef _SCOPE_HPP_
 #define _SCOPE_HPP_
 
-#include <unordered_map>
-#include <list>
 #include <string>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
 #include "symbol.hpp"
 #include "abstract_syntax.hpp"
 
+class symbol_table;
+
+// the symbols of a scope, in the order they were added.
+class symbol_range
+{
+    private:
+
+    const symbol* const* first;
+    const symbol* const* last;
+
+    public:
+
+    symbol_range(const symbol* const* first, const symbol* const* last);
+
+    const symbol* const* begin() const;
+    const symbol* const* end() const;
+
+    std::size_t size() const;
+
+    const symbol* back() const;
+};
+
+// a range of the symbols of the open scopes, which the symbol_table keeps one after another.
+// only the innermost scope grows, so the range of an outer scope ends where the next one begins.
 class scope
 {
     friend class symbol_table;
 
     private:
 
-    std::list<const symbol*> symbol_list;
-    std::unordered_map<std::string, const symbol*> symbol_map;
+    const symbol_table* table;
+    std::size_t first;
+    std::size_t last;
     int offset;
     int param_offset;
 
-    public:
+    // loop scopes among this one and those around it.
+    std::size_t loop_depth;
 
-    const bool loop_scope;
+    // the index of the symbol with the name id in this scope, or none.
+    std::uint32_t index_of(std::uint32_t id) const;
 
-    scope(int offset, bool loop_scope);
+    public:
 
-    ~scope();
+    static constexpr std::uint32_t none = UINT32_MAX;
 
-    bool contains_symbol(const std::string& name) const;
+    const bool loop_scope;
 
-    const symbol* get_symbol(const std::string& name) const;
+    scope(const symbol_table& table, std::size_t first, int offset, std::size_t loop_depth, bool loop_scope);
 
-    const std::list<const symbol*>& get_symbols() const;
+    bool contains_symbol(std::uint32_t id) const;
 
-    bool add_variable(const std::string& name, type_kind type);
+    const symbol* get_symbol(std::uint32_t id) const;
 
-    bool add_parameter(const std::string& name, type_kind type);
+    // how many symbols were added before the one with the name id, which the scope must contain.
+    std::size_t position_of(std::uint32_t id) const;
 
-    bool add_function(const std::string& name, type_kind return_type, const std::vector<type_kind>& parameter_types);
+    symbol_range get_symbols() const;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,104 @@
+#include "socket_frames.hpp"
+#include <cstring>
+#include <cerrno>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using std::size_t;
+using std::uint32_t;
+using std::string;
+using std::string_view;
+
+static bool write_all(int fd, const char* data, size_t size)
+{
+    while (size != 0)
+    {
+        ssize_t count = send(fd, data, size, MSG_NOSIGNAL);
+
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (count <= 0)
+        {
+            return false;
+        }
+
+        data += count;
+        size -= static_cast<size_t>(count);
+    }
+
+    return true;
+}
+
+static bool read_all(int fd, char* data, size_t size)
+{
+    while (size != 0)
+    {
+        ssize_t count = recv(fd, data, size, 0);
+
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (count <= 0)
+        {
+            return false;
+        }
+
+        data += count;
+        size -= static_cast<size_t>(count);
+    }
+
+    return true;
+}
+
+bool socket_frames::write(int fd, string_view message)
+{
+    uint32_t size = static_cast<uint32_t>(message.size());
+
+    return write_all(fd, reinterpret_cast<const char*>(&size), header_size) && write_all(fd, message.data(), message.size());
+}
+
+bool socket_frames::read(int fd, string& message)
+{
+    uint32_t size;
+
+    if (read_all(fd, reinterpret_cast<char*>(&size), header_size) == false || size > max_size)
+    {
+        return false;
+    }
+
+    message.resize(size);
+    return read_all(fd, message.data(), size);
+}
+
+bool socket_frames::extract(string& input, string& message, bool& broken)
+{
+    uint32_t size;
+
+    if (input.size() < header_size)
+    {
+        return false;
+    }
+
+    std::memcpy(&size, input.data(), header_size);
+
+    if (size > max_size)
+    {
+        broken = true;
+        return false;
+    }
+
+    if (input.size() - header_size < size)
+    {
+        return false;
+    }
+
+    message.assign(input, header_size, size);
+    input.erase(0, header_size + size);
+    return true;
+}
@@ -0,0 +1,27 @@
+#ifndef _SOCKET_FRAMES_HPP_
+#define _SOCKET_FRAMES_HPP_
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+
+// messages on a local socket: a 4-byte length in host byte order, followed by that many bytes.
+namespace socket_frames
+{
+    constexpr std::size_t header_size = sizeof(std::uint32_t);
+
+    // longest message accepted, a longer length is taken as a broken connection.
+    constexpr std::size_t max_size = 64 * 1024 * 1024;
+
+    // blocks until the whole message is written, false once the peer is gone.
+    bool write(int fd, std::string_view message);
+
+    // blocks until a whole message is read, false at the end of the connection or on a broken message.
+    bool read(int fd, std::string& message);
+
+    // takes the first complete message off the front of buffered input. false when none is complete yet, or when broken is set.
+    bool extract(std::string& input, std::string& message, bool& broken);
+}
+
+#endif
@@ -0,0 +1,190 @@
+#include "source_buffer.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <new>
+#include <system_error>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using std::size_t;
+
+static size_t round_up(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+source_buffer::source_buffer(): buffer(nullptr), length(0), mapped_length(0)
+{
+    read_stream(STDIN_FILENO);
+}
+
+source_buffer::source_buffer(const char* path): buffer(nullptr), length(0), mapped_length(0)
+{
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0)
+    {
+        throw std::system_error(errno, std::generic_category(), path);
+    }
+
+    struct stat info;
+
+    try
+    {
+        if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0)
+        {
+            map_file(fd, static_cast<size_t>(info.st_size));
+        }
+        else
+        {
+            read_stream(fd);
+        }
+    }
+    catch (...)
+    {
+        close(fd);
+        throw;
+    }
+
+    close(fd);
+}
+
+source_buffer::source_buffer(const char* text, size_t size): buffer(static_cast<char*>(std::malloc(size + padding))), length(size), mapped_length(0)
+{
+    if (buffer == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    std::memcpy(buffer, text, size);
+    std::memset(buffer + length, 0, padding);
+}
+
+source_buffer::~source_buffer()
+{
+    if (mapped_length != 0)
+    {
+        munmap(buffer, mapped_length);
+    }
+    else
+    {
+        std::free(buffer);
+    }
+}
+
+void source_buffer::map_file(int fd, size_t file_length)
+{
+    size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t file_pages = round_up(file_length, page_size);
+    size_t total = round_up(file_length + padding, page_size);
+
+    // reserve the padded range as zeroed anonymous memory, then map the file over its head.
+    // the tail of the last file page is zero-filled by the kernel, so the padding comes for free.
+    void* region = mmap(nullptr, total, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (region == MAP_FAILED)
+    {
+        throw std::system_error(errno, std::generic_category(), "mmap");
+    }
+
+    // read-only until flex asks to scan it in place, the other lexers never write it.
+    if (mmap(region, file_pages, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED)
+    {
+        int error = errno;
+        munmap(region, total);
+        throw std::system_error(error, std::generic_category(), "mmap");
+    }
+
+    madvise(region, file_pages, MADV_SEQUENTIAL);
+
+    buffer = static_cast<char*>(region);
+    length = file_length;
+    mapped_length = total;
+}
+
+void source_buffer::read_stream(int fd)
+{
+    size_t capacity = 1 << 16;
+
+    buffer = static_cast<char*>(std::malloc(capacity));
+
+    if (buffer == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    // a throw leaves the constructor, whose destructor then never runs, so the buffer is freed before each one.
+    while (true)
+    {
+        if (capacity - length < padding + 1)
+        {
+            char* grown = static_cast<char*>(std::realloc(buffer, capacity * 2));
+
+            if (grown == nullptr)
+            {
+                std::free(buffer);
+                buffer = nullptr;
+                throw std::bad_alloc();
+            }
+
+            buffer = grown;
+            capacity *= 2;
+            continue;
+        }
+
+        ssize_t count = read(fd, buffer + length, capacity - length - padding);
+
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (count < 0)
+        {
+            int error = errno;
+            std::free(buffer);
+            buffer = nullptr;
+            throw std::system_error(error, std::generic_category(), "read");
+        }
+
+        if (count == 0)
+        {
+            break;
+        }
+
+        length += static_cast<size_t>(count);
+    }
+
+    std::memset(buffer + length, 0, padding);
+}
+
+char* source_buffer::data()
+{
+    return buffer;
+}
+
+const char* source_buffer::data() const
+{
+    return buffer;
+}
+
+size_t source_buffer::size() const
+{
+    return length;
+}
+
+bool source_buffer::is_mapped() const
+{
+    return mapped_length != 0;
+}
+
+void source_buffer::make_writable()
+{
+    if (mapped_length != 0 && mprotect(buffer, mapped_length, PROT_READ | PROT_WRITE) != 0)
+    {
+        throw std::system_error(errno, std::generic_category(), "mprotect");
+    }
+}
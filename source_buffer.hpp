@@ -0,0 +1,46 @@
+#ifndef _SOURCE_BUFFER_HPP_
+#define _SOURCE_BUFFER_HPP_
+
+#include <cstddef>
+
+// holds the whole program text in one contiguous buffer, followed by padding NUL bytes.
+// the first two of them terminate the buffer as flex's yy_scan_buffer requires, the rest let vectorized scans read whole blocks past the end.
+// regular files are memory-mapped read-only and scanned in place, anything else (stdin, pipes, text already in memory) is copied into a heap buffer.
+// a mapping is private, so making it writable copies only the pages written, and never changes the file.
+class source_buffer
+{
+    private:
+
+    char* buffer;
+    std::size_t length;
+    std::size_t mapped_length;
+
+    void map_file(int fd, std::size_t file_length);
+    void read_stream(int fd);
+
+    public:
+
+    static constexpr std::size_t terminator_length = 2;
+    static constexpr std::size_t padding = 64;
+
+    source_buffer();
+    source_buffer(const char* path);
+    source_buffer(const char* text, std::size_t size);
+    ~source_buffer();
+
+    source_buffer(const source_buffer& other) = delete;
+    source_buffer& operator=(const source_buffer& other) = delete;
+
+    // the text may only be written when it is not mapped, or once make_writable was called.
+    char* data();
+    const char* data() const;
+
+    std::size_t size() const;
+
+    bool is_mapped() const;
+
+    // lets a mapped text be written, as flex writes a NUL after each token it scans and restores the byte after it.
+    void make_writable();
+};
+
+#endif
@@ -0,0 +1,254 @@
+#include "source_index.hpp"
+#include <stdexcept>
+#include <limits>
+#include <algorithm>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+using std::size_t;
+using std::uint32_t;
+using std::uint64_t;
+
+namespace
+{
+    source_index::scan_kind scan = source_index::scan_kind::Vector;
+
+    // the masks set bit i when block[i] matches, reading exactly block_size bytes.
+    // match_mask matches any of chars, word_mask a letter or a digit.
+
+    template<char... chars> inline uint64_t scalar_match_mask(const char* block)
+    {
+        uint64_t mask = 0;
+
+        for (size_t i = 0; i < source_index::block_size; i++)
+        {
+            mask |= static_cast<uint64_t>(((block[i] == chars) || ...)) << i;
+        }
+
+        return mask;
+    }
+
+    inline uint64_t scalar_word_mask(const char* block)
+    {
+        uint64_t mask = 0;
+
+        for (size_t i = 0; i < source_index::block_size; i++)
+        {
+            char c = block[i];
+            bool word = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+            mask |= static_cast<uint64_t>(word) << i;
+        }
+
+        return mask;
+    }
+
+#if defined(__AVX2__)
+    template<char... chars> inline uint64_t match_chunk(const char* chunk)
+    {
+        __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chunk));
+        __m256i matches = _mm256_setzero_si256();
+        ((matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(input, _mm256_set1_epi8(chars)))), ...);
+        return static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(matches)));
+    }
+
+    template<char... chars> inline uint64_t vector_match_mask(const char* block)
+    {
+        return match_chunk<chars...>(block) | (match_chunk<chars...>(block + 32) << 32);
+    }
+
+    // bytes in [first, first + count): shifted so that the range starts at -128, they are the ones below -128 + count.
+    inline __m256i in_range(__m256i input, char first, char count)
+    {
+        __m256i shifted = _mm256_sub_epi8(input, _mm256_set1_epi8(static_cast<char>(first + 128)));
+        return _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(-128 + count)), shifted);
+    }
+
+    inline uint64_t word_chunk(const char* chunk)
+    {
+        __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chunk));
+        __m256i letters = in_range(_mm256_or_si256(input, _mm256_set1_epi8(0x20)), 'a', 26);
+        __m256i words = _mm256_or_si256(letters, in_range(input, '0', 10));
+        return static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(words)));
+    }
+
+    inline uint64_t vector_word_mask(const char* block)
+    {
+        return word_chunk(block) | (word_chunk(block + 32) << 32);
+    }
+#elif defined(__SSE2__)
+    template<char... chars> inline uint64_t match_chunk(const char* chunk)
+    {
+        __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chunk));
+        __m128i matches = _mm_setzero_si128();
+        ((matches = _mm_or_si128(matches, _mm_cmpeq_epi8(input, _mm_set1_epi8(chars)))), ...);
+        return static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(matches)));
+    }
+
+    template<char... chars> inline uint64_t vector_match_mask(const char* block)
+    {
+        return match_chunk<chars...>(block) | (match_chunk<chars...>(block + 16) << 16) |
+            (match_chunk<chars...>(block + 32) << 32) | (match_chunk<chars...>(block + 48) << 48);
+    }
+
+    // bytes in [first, first + count): shifted so that the range starts at -128, they are the ones below -128 + count.
+    inline __m128i in_range(__m128i input, char first, char count)
+    {
+        __m128i shifted = _mm_sub_epi8(input, _mm_set1_epi8(static_cast<char>(first + 128)));
+        return _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(-128 + count)));
+    }
+
+    inline uint64_t word_chunk(const char* chunk)
+    {
+        __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chunk));
+        __m128i letters = in_range(_mm_or_si128(input, _mm_set1_epi8(0x20)), 'a', 26);
+        __m128i words = _mm_or_si128(letters, in_range(input, '0', 10));
+        return static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(words)));
+    }
+
+    inline uint64_t vector_word_mask(const char* block)
+    {
+        return word_chunk(block) | (word_chunk(block + 16) << 16) | (word_chunk(block + 32) << 32) | (word_chunk(block + 48) << 48);
+    }
+#else
+    template<char... chars> inline uint64_t vector_match_mask(const char* block)
+    {
+        return scalar_match_mask<chars...>(block);
+    }
+
+    inline uint64_t vector_word_mask(const char* block)
+    {
+        return scalar_word_mask(block);
+    }
+#endif
+
+    template<char... chars> inline uint64_t match_mask(const char* block)
+    {
+        return scan == source_index::scan_kind::Vector ? vector_match_mask<chars...>(block) : scalar_match_mask<chars...>(block);
+    }
+
+    inline uint64_t word_mask(const char* block)
+    {
+        return scan == source_index::scan_kind::Vector ? vector_word_mask(block) : scalar_word_mask(block);
+    }
+
+    inline size_t first_bit(uint64_t mask)
+    {
+        return static_cast<size_t>(__builtin_ctzll(mask));
+    }
+
+    // first position at or after position whose bit is set in block_mask, or end.
+    // the source padding keeps the whole block of a position before end readable.
+    template<typename mask_function> const char* find_first(const char* begin, const char* end, const char* position, mask_function block_mask)
+    {
+        size_t shift = static_cast<size_t>(position - begin) % source_index::block_size;
+        const char* block = position - shift;
+
+        uint64_t mask = block_mask(block) >> shift;
+
+        if (mask != 0)
+        {
+            const char* found = position + first_bit(mask);
+            return found < end ? found : end;
+        }
+
+        for (block += source_index::block_size; block < end; block += source_index::block_size)
+        {
+            mask = block_mask(block);
+
+            if (mask != 0)
+            {
+                const char* found = block + first_bit(mask);
+                return found < end ? found : end;
+            }
+        }
+
+        return end;
+    }
+}
+
+void source_index::set_scan(scan_kind kind)
+{
+    scan = kind;
+}
+
+source_index::scan_kind source_index::get_scan()
+{
+    return scan;
+}
+
+source_index::source_index(): newlines(), indexed(0)
+{
+}
+
+source_index::source_index(const source_buffer& source): newlines(), indexed(0)
+{
+    append(source.data(), source.size());
+}
+
+void source_index::append(const char* text, size_t length)
+{
+    if (length > std::numeric_limits<uint32_t>::max() - indexed)
+    {
+        throw std::length_error("source too large to index");
+    }
+
+    const char* end = text + length;
+
+    for (const char* block = text; block < end; block += block_size)
+    {
+        uint64_t mask = match_mask<'\n'>(block);
+
+        // the last block reads into the padding, which must not count.
+        if (static_cast<size_t>(end - block) < block_size)
+        {
+            mask &= (uint64_t(1) << (end - block)) - 1;
+        }
+
+        while (mask != 0)
+        {
+            newlines.push_back(static_cast<uint32_t>(indexed + (block - text) + first_bit(mask)));
+            mask &= mask - 1;
+        }
+    }
+
+    indexed += length;
+}
+
+void source_index::clear()
+{
+    newlines.clear();
+    indexed = 0;
+}
+
+const std::vector<uint32_t>& source_index::get_newlines() const
+{
+    return newlines;
+}
+
+int source_index::line_of(size_t offset) const
+{
+    auto preceding = std::lower_bound(newlines.begin(), newlines.end(), offset);
+    return static_cast<int>(preceding - newlines.begin()) + 1;
+}
+
+const char* source_index::skip_whitespace(const char* begin, const char* end, const char* position)
+{
+    return find_first(begin, end, position, [](const char* block) { return ~match_mask<' ', '\t', '\r', '\n'>(block); });
+}
+
+const char* source_index::find_line_break(const char* begin, const char* end, const char* position)
+{
+    return find_first(begin, end, position, [](const char* block) { return match_mask<'\r', '\n'>(block); });
+}
+
+const char* source_index::find_string_stop(const char* begin, const char* end, const char* position)
+{
+    return find_first(begin, end, position, [](const char* block) { return match_mask<'"', '\\', '\r', '\n'>(block); });
+}
+
+const char* source_index::skip_word(const char* begin, const char* end, const char* position)
+{
+    return find_first(begin, end, position, [](const char* block) { return ~word_mask(block); });
+}
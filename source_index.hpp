@@ -0,0 +1,63 @@
+#ifndef _SOURCE_INDEX_HPP_
+#define _SOURCE_INDEX_HPP_
+
+#include "source_buffer.hpp"
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// structural pre-scan of the source, done 64 bytes at a time with SSE2/AVX2 when available, or with a loop over each block.
+// holds the offset of every newline, and answers the skip queries the lexer needs from per-block character masks.
+// the spans of comments, strings and words are found on demand rather than stored: the lexer asks for each once, in order,
+// and a stored array of them would be written and read back for every one.
+// the skip queries look at [begin, end), and read whole blocks aligned to begin, so the text must be padded like source_buffer.
+class source_index
+{
+    private:
+
+    std::vector<std::uint32_t> newlines;
+    std::size_t indexed;
+
+    public:
+
+    static constexpr std::size_t block_size = 64;
+
+    // how the blocks are matched. Vector is the loop in a build without SSE2 or AVX2.
+    enum class scan_kind { Vector, Scalar };
+
+    // the scan of every index in the process, Vector unless set. set it before any check starts.
+    static void set_scan(scan_kind kind);
+    static scan_kind get_scan();
+
+    // an empty index, for text that is appended as it arrives.
+    source_index();
+    source_index(const source_buffer& source);
+
+    source_index(const source_index& other) = delete;
+    source_index& operator=(const source_index& other) = delete;
+
+    // indexes the newlines of text that continues the source indexed so far.
+    void append(const char* text, std::size_t length);
+
+    // forgets the indexed text, keeping the memory for the next source.
+    void clear();
+
+    const std::vector<std::uint32_t>& get_newlines() const;
+
+    // line of the character at offset, by binary search over the newline offsets.
+    int line_of(std::size_t offset) const;
+
+    // first position at or after position that is not whitespace.
+    static const char* skip_whitespace(const char* begin, const char* end, const char* position);
+
+    // first '\r' or '\n' at or after position, ends a comment.
+    static const char* find_line_break(const char* begin, const char* end, const char* position);
+
+    // first '"', '\\', '\r' or '\n' at or after position, ends a run of plain string literal characters.
+    static const char* find_string_stop(const char* begin, const char* end, const char* position);
+
+    // first position at or after position that is not a letter or a digit, ends an identifier.
+    static const char* skip_word(const char* begin, const char* end, const char* position);
+};
+
+#endif
@@ -0,0 +1,93 @@
+#include "source_stream.hpp"
+#include "source_buffer.hpp"
+#include <cstring>
+#include <algorithm>
+
+using std::size_t;
+
+source_stream::source_stream(source_index& index): index(index), blocks(), scanner(), finished(false)
+{
+}
+
+void source_stream::start_block(size_t size)
+{
+    const char* rest = nullptr;
+    size_t rest_length = 0;
+    size_t base = 0;
+
+    if (blocks.empty() == false)
+    {
+        const block& current = blocks.back();
+
+        rest = scanner->position();
+        rest_length = current.length - (rest - current.data.get());
+        base = current.base + (rest - current.data.get());
+    }
+
+    block next;
+    next.capacity = std::max(block_size, rest_length + size);
+    next.data.reset(new char[next.capacity + source_buffer::padding]());
+    next.length = rest_length;
+    next.base = base;
+
+    if (rest_length != 0)
+    {
+        std::memcpy(next.data.get(), rest, rest_length);
+    }
+
+    scanner.reset(new lexer(next.data.get(), next.data.get() + next.length, base, finished));
+    blocks.push_back(std::move(next));
+}
+
+void source_stream::append(const char* data, size_t size)
+{
+    if (blocks.empty() || blocks.back().capacity - blocks.back().length < size)
+    {
+        start_block(size);
+    }
+
+    block& current = blocks.back();
+    char* destination = current.data.get() + current.length;
+
+    std::memcpy(destination, data, size);
+    current.length += size;
+
+    // indexed from the block, whose padding the vectorized scan may read.
+    index.append(destination, size);
+    scanner->extend(current.data.get() + current.length);
+}
+
+void source_stream::finish()
+{
+    if (blocks.empty())
+    {
+        start_block(0);
+    }
+
+    finished = true;
+    scanner->finish();
+}
+
+yytoken_kind_t source_stream::next(YYSTYPE* value, syntax_arena& arena)
+{
+    if (scanner == nullptr)
+    {
+        return YYEMPTY;
+    }
+
+    return scanner->next(value, arena);
+}
+
+size_t source_stream::last_offset() const
+{
+    return scanner->last_offset();
+}
+
+void source_stream::release(size_t offset)
+{
+    // a block holds the text up to where the next one starts, the rest of it was moved over.
+    while (blocks.size() > 1 && blocks[1].base <= offset)
+    {
+        blocks.pop_front();
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef _SOURCE_STREAM_HPP_
+#define _SOURCE_STREAM_HPP_
+
+#include "parser.tab.hpp"
+#include "source_index.hpp"
+#include "lexer.hpp"
+#include <deque>
+#include <memory>
+#include <cstddef>
+
+// program text that arrives in chunks, lexed as it comes.
+// the text is kept in blocks and every token lies within one of them, so a block is freed as soon as no token refers to it.
+class source_stream
+{
+    private:
+
+    struct block
+    {
+        std::unique_ptr<char[]> data;
+        std::size_t capacity;
+        std::size_t length;
+        std::size_t base;
+    };
+
+    static constexpr std::size_t block_size = 64 * 1024;
+
+    source_index& index;
+    std::deque<block> blocks;
+    std::unique_ptr<lexer> scanner;
+    bool finished;
+
+    // starts a block that fits size more bytes, moving the text not lexed yet over from the current one.
+    void start_block(std::size_t size);
+
+    public:
+
+    source_stream(source_index& index);
+
+    source_stream(const source_stream& other) = delete;
+    source_stream& operator=(const source_stream& other) = delete;
+
+    void append(const char* data, std::size_t size);
+
+    // no more text will follow.
+    void finish();
+
+    // next token, or YYEMPTY when it is not complete yet.
+    yytoken_kind_t next(YYSTYPE* value, syntax_arena& arena);
+
+    std::size_t last_offset() const;
+
+    // frees the blocks that hold no text at or after offset.
+    void release(std::size_t offset);
+};
+
+#endif
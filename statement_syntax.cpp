@@ -2,32 +2,31 @@
 #include "output.hpp"
 #include "symbol_table.hpp"
 #include "abstract_syntax.hpp"
-#include <list>
-#include <algorithm>
+#include <vector>
 #include <stdexcept>
 
 using std::string;
+using std::string_view;
 using std::vector;
-using std::list;
 
-if_statement::if_statement(syntax_token* if_token, expression_syntax* condition, statement_syntax* body):
-    if_token(if_token), condition(condition), body(body), else_token(nullptr), else_clause(nullptr)
+if_statement::if_statement(checker_context& context, syntax_token* if_token, expression_syntax* condition, statement_syntax* body):
+    statement_syntax(syntax_kind::If), if_token(if_token), condition(condition), body(body), else_token(nullptr), else_clause(nullptr)
 {
-    if (condition->return_type != type_kind::Bool)
+    if (condition->is_poisoned() == false && condition->return_type != type_kind::Bool)
     {
-        output::error_mismatch(if_token->position);
+        output::error_mismatch(context.line_of(if_token));
     }
 
     push_back_child(condition);
     push_back_child(body);
 }
 
-if_statement::if_statement(syntax_token* if_token, expression_syntax* condition, statement_syntax* body, syntax_token* else_token, statement_syntax* else_clause):
-    if_token(if_token), condition(condition), body(body), else_token(else_token), else_clause(else_clause)
+if_statement::if_statement(checker_context& context, syntax_token* if_token, expression_syntax* condition, statement_syntax* body, syntax_token* else_token, statement_syntax* else_clause):
+    statement_syntax(syntax_kind::If), if_token(if_token), condition(condition), body(body), else_token(else_token), else_clause(else_clause)
 {
-    if (condition->return_type != type_kind::Bool)
+    if (condition->is_poisoned() == false && condition->return_type != type_kind::Bool)
     {
-        output::error_mismatch(if_token->position);
+        output::error_mismatch(context.line_of(if_token));
     }
 
     push_back_child(condition);
@@ -35,71 +34,40 @@ if_statement::if_statement(syntax_token* if_token, expression_syntax* condition,
     push_back_child(else_clause);
 }
 
-if_statement::~if_statement()
+while_statement::while_statement(checker_context& context, syntax_token* while_token, expression_syntax* condition, statement_syntax* body):
+    statement_syntax(syntax_kind::While), while_token(while_token), condition(condition), body(body)
 {
-    for (syntax_base* child : get_children())
+    if (condition->is_poisoned() == false && condition->return_type != type_kind::Bool)
     {
-        delete child;
-    }
-
-    delete if_token;
-    delete else_token;
-}
-
-while_statement::while_statement(syntax_token* while_token, expression_syntax* condition, statement_syntax* body):
-    while_token(while_token), condition(condition), body(body)
-{
-    if (condition->return_type != type_kind::Bool)
-    {
-        output::error_mismatch(while_token->position);
+        output::error_mismatch(context.line_of(while_token));
     }
 
     push_back_child(condition);
     push_back_child(body);
 }
 
-while_statement::~while_statement()
-{
-    for (syntax_base* child : get_children())
-    {
-        delete child;
-    }
-
-    delete while_token;
-}
-
-branch_statement::branch_statement(syntax_token* branch_token):
-    branch_token(branch_token), kind(parse_kind(branch_token->text))
+branch_statement::branch_statement(checker_context& context, syntax_token* branch_token):
+    statement_syntax(syntax_kind::Branch), branch_token(branch_token), kind(parse_kind(branch_token->text))
 {
-    const list<scope>& scopes = symbol_table::instance().get_scopes();
-
-    if (std::all_of(scopes.rbegin(), scopes.rend(), [](const scope& sc) { return sc.loop_scope == false; }))
+    if (context.symtab.loop_depth() == 0)
     {
         if (kind == branch_kind::Break)
         {
-            output::error_unexpected_break(branch_token->position);
+            output::error_unexpected_break(context.line_of(branch_token));
+            return;
         }
 
         if (kind == branch_kind::Continue)
         {
-            output::error_unexpected_continue(branch_token->position);
+            output::error_unexpected_continue(context.line_of(branch_token));
+            return;
         }
 
         throw std::runtime_error("unknown branch_kind");
     }
 }
 
-branch_statement::~branch_statement()
-{
-    for (syntax_base* child : get_children())
-    {
-        delete child;
-    }
-
-    delete branch_token;
-}
-
-branch_statement::branch_kind branch_statement::parse_kind(string str)
+branch_statement::branch_kind branch_statement::parse_kind(string_view str)
 {
     if (str == "break") return branch_kind::Break;
     if (str == "continue") return branch_kind::Continue;
@@ -107,148 +75,98 @@ branch_statement::branch_kind branch_statement::parse_kind(string str)
     throw std::invalid_argument("unknown type");
 }
 
-return_statement::return_statement(syntax_token* return_token):
-    return_token(return_token), value(nullptr)
+return_statement::return_statement(checker_context& context, syntax_token* return_token):
+    statement_syntax(syntax_kind::Return), return_token(return_token), value(nullptr)
 {
-    auto& global_symbols = symbol_table::instance().get_scopes().front().get_symbols();
-
-    const symbol* func_sym = global_symbols.back();
+    const symbol* func_sym = context.symtab.current_function();
 
-    if (func_sym->type != type_kind::Void)
+    // a function that was already defined has no signature of its own to check against.
+    if (func_sym != nullptr && func_sym->type != type_kind::Void)
     {
-        output::error_mismatch(return_token->position);
+        output::error_mismatch(context.line_of(return_token));
     }
 }
 
-return_statement::return_statement(syntax_token* return_token, expression_syntax* value):
-    return_token(return_token), value(value)
+return_statement::return_statement(checker_context& context, syntax_token* return_token, expression_syntax* value):
+    statement_syntax(syntax_kind::Return), return_token(return_token), value(value)
 {
-    auto& global_symbols = symbol_table::instance().get_scopes().front().get_symbols();
-
-    const symbol* func_sym = global_symbols.back();
+    const symbol* func_sym = context.symtab.current_function();
 
-    if (types::is_implictly_convertible(value->return_type, func_sym->type) == false)
+    if (func_sym != nullptr && value->is_poisoned() == false && types::is_implictly_convertible(value->return_type, func_sym->type) == false)
     {
-        output::error_mismatch(return_token->position);
+        output::error_mismatch(context.line_of(return_token));
     }
 
     push_back_child(value);
 }
 
-return_statement::~return_statement()
-{
-    for (syntax_base* child : get_children())
-    {
-        delete child;
-    }
-
-    delete return_token;
-}
-
-expression_statement::expression_statement(expression_syntax* expression): expression(expression)
+expression_statement::expression_statement(expression_syntax* expression): statement_syntax(syntax_kind::ExpressionStatement), expression(expression)
 {
     push_back_child(expression);
 }
 
-expression_statement::~expression_statement()
-{
-    for (syntax_base* child : get_children())
-    {
-        delete child;
-    }
-}
-
-assignment_statement::assignment_statement(syntax_token* identifier_token, syntax_token* assign_token, expression_syntax* value):
-    identifier_token(identifier_token), identifier(identifier_token->text), assign_token(assign_token), value(value)
+assignment_statement::assignment_statement(checker_context& context, syntax_token* identifier_token, syntax_token* assign_token, expression_syntax* value):
+    statement_syntax(syntax_kind::Assignment), identifier_token(identifier_token), identifier(identifier_token->text), assign_token(assign_token), value(value),
+    resolved(context.symtab.get_symbol(identifier_token->id))
 {
-    const symbol* identifier_symbol = symbol_table::instance().get_symbol(identifier);
-
-    if (identifier_symbol == nullptr || identifier_symbol->kind != symbol_kind::Variable)
+    if (resolved == nullptr || resolved->kind != symbol_kind::Variable)
     {
-        output::error_undef(identifier_token->position, identifier);
+        output::error_undef(context.line_of(identifier_token), identifier);
     }
-
-    if (types::is_implictly_convertible(value->return_type, identifier_symbol->type) == false)
+    else if (value->is_poisoned() == false && types::is_implictly_convertible(value->return_type, resolved->type) == false)
     {
-        output::error_mismatch(assign_token->position);
+        output::error_mismatch(context.line_of(assign_token));
     }
 
     push_back_child(value);
 }
 
-assignment_statement::~assignment_statement()
+declaration_statement::declaration_statement(checker_context& context, type_syntax* type, syntax_token* identifier_token):
+    statement_syntax(syntax_kind::Declaration), type(type), identifier_token(identifier_token), identifier(identifier_token->text), assign_token(nullptr), value(nullptr)
 {
-    for (syntax_base* child : get_children())
+    if (type->is_special())
     {
-        delete child;
+        output::error_mismatch(context.line_of(identifier_token));
     }
 
-    delete identifier_token;
-    delete assign_token;
-}
-
-declaration_statement::declaration_statement(type_syntax* type, syntax_token* identifier_token):
-    type(type), identifier_token(identifier_token), identifier(identifier_token->text), assign_token(nullptr), value(nullptr)
-{
-    if (type->is_special())
+    if (context.symtab.contains_symbol(identifier_token->id))
     {
-        output::error_mismatch(identifier_token->position);
+        output::error_def(context.line_of(identifier_token), identifier);
     }
-
-    if (symbol_table::instance().contains_symbol(identifier))
+    else
     {
-        output::error_def(identifier_token->position, identifier);
+        context.symtab.add_variable(identifier_token->id, type->kind);
     }
 
-    symbol_table::instance().add_variable(identifier, type->kind);
-
     push_back_child(type);
 }
 
-declaration_statement::declaration_statement(type_syntax* type, syntax_token* identifier_token, syntax_token* assign_token, expression_syntax* value):
-    type(type), identifier_token(identifier_token), identifier(identifier_token->text), assign_token(assign_token), value(value)
+declaration_statement::declaration_statement(checker_context& context, type_syntax* type, syntax_token* identifier_token, syntax_token* assign_token, expression_syntax* value):
+    statement_syntax(syntax_kind::Declaration), type(type), identifier_token(identifier_token), identifier(identifier_token->text), assign_token(assign_token), value(value)
 {
-    if (type->is_special() || value->is_special())
+    if (value->is_poisoned() == false && (type->is_special() || value->is_special()))
     {
-        output::error_mismatch(identifier_token->position);
+        output::error_mismatch(context.line_of(identifier_token));
     }
-
-    if (types::is_implictly_convertible(value->return_type, type->kind) == false)
+    else if (value->is_poisoned() == false && types::is_implictly_convertible(value->return_type, type->kind) == false)
     {
-        output::error_mismatch(identifier_token->position);
+        output::error_mismatch(context.line_of(identifier_token));
     }
 
-    if (symbol_table::instance().contains_symbol(identifier))
+    if (context.symtab.contains_symbol(identifier_token->id))
     {
-        output::error_def(identifier_token->position, identifier);
+        output::error_def(context.line_of(identifier_token), identifier);
     }
-
-    symbol_table::instance().add_variable(identifier, type->kind);
-
-    push_back_child(type);
-    push_back_child(value);
-}
-
-declaration_statement::~declaration_statement()
-{
-    for (syntax_base* child : get_children())
+    else
     {
-        delete child;
+        context.symtab.add_variable(identifier_token->id, type->kind);
     }
 
-    delete identifier_token;
-    delete assign_token;
+    push_back_child(type);
+    push_back_child(value);
 }
 
-block_statement::block_statement(list_syntax<statement_syntax>* statements): statements(statements)
+block_statement::block_statement(list_syntax<statement_syntax>* statements): statement_syntax(syntax_kind::Block), statements(statements)
 {
     push_back_child(statements);
 }
-
-block_statement::~block_statement()
-{
-    for (syntax_base* child : get_children())
-    {
-        delete child;
-    }
-}
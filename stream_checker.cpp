@@ -0,0 +1,83 @@
+#include "stream_checker.hpp"
+#include "output.hpp"
+#include <exception>
+
+using std::size_t;
+
+stream_checker::stream_checker(const check_options& options, std::ostream& out):
+    context(), parser(yypstate_new()), done(false), failure()
+{
+    output::set_stream(out);
+    output::set_max_errors(options.max_errors);
+
+    context.open_global_scope();
+}
+
+stream_checker::~stream_checker()
+{
+    yypstate_delete(parser);
+}
+
+void stream_checker::parse_available()
+{
+    try
+    {
+        while (done == false)
+        {
+            YYSTYPE value;
+            int kind = context.next_token(&value);
+
+            if (kind == YYEMPTY)
+            {
+                return;
+            }
+
+            int status = yypush_parse(parser, kind, &value, context);
+
+            if (status != YYPUSH_MORE)
+            {
+                // a parse only fails when error recovery gave up, after the syntax error was reported.
+                if (status == 0)
+                {
+                    context.close_global_scope();
+                }
+
+                done = true;
+            }
+        }
+    }
+    catch (const output::check_aborted&)
+    {
+        done = true;
+    }
+    catch (const std::exception& error)
+    {
+        failure = error.what();
+        done = true;
+    }
+}
+
+bool stream_checker::feed(const char* data, size_t size)
+{
+    if (done == false)
+    {
+        context.append_source(data, size);
+        parse_available();
+    }
+
+    return done == false;
+}
+
+void stream_checker::finish()
+{
+    if (done == false)
+    {
+        context.finish_source();
+        parse_available();
+    }
+}
+
+const std::string& stream_checker::get_failure() const
+{
+    return failure;
+}
@@ -0,0 +1,42 @@
+#ifndef _STREAM_CHECKER_HPP_
+#define _STREAM_CHECKER_HPP_
+
+#include "parser.tab.hpp"
+#include "checker_context.hpp"
+#include <ostream>
+#include <string>
+#include <cstddef>
+
+// checks a program fed in arbitrary chunks, driving the push parser with each token as soon as it is complete.
+// scope dumps and diagnostics are written the moment they are determined, and each function is freed once it reduces.
+class stream_checker
+{
+    private:
+
+    checker_context context;
+    yypstate* parser;
+    bool done;
+    std::string failure;
+
+    // pushes every complete token to the parser.
+    void parse_available();
+
+    public:
+
+    stream_checker(const check_options& options, std::ostream& out);
+    ~stream_checker();
+
+    stream_checker(const stream_checker& other) = delete;
+    stream_checker& operator=(const stream_checker& other) = delete;
+
+    // returns false once the check is over, after which further chunks are ignored.
+    bool feed(const char* data, std::size_t size);
+
+    // ends the input and completes the check.
+    void finish();
+
+    // what ended the check when it failed rather than completed, empty otherwise.
+    const std::string& get_failure() const;
+};
+
+#endif
@@ -1,55 +1,66 @@
 #include "symbol.hpp"
 #include <vector>
-#include <sstream>
+#include <charconv>
 
 using std::string;
+using std::string_view;
 using std::vector;
-using std::stringstream;
+using std::size_t;
+using std::uint32_t;
 
-symbol::symbol(const string& name, type_kind type, int offset, symbol_kind kind):
-    kind(kind), name(name), offset(offset), type(type)
+static void append_number(string& out, int value)
 {
+    char digits[16];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
 
+    out.append(digits, result.ptr);
 }
 
-variable_symbol::variable_symbol(const string& name, type_kind type, int offset):
-    symbol(name, type, offset, symbol_kind::Variable)
+symbol::symbol(string_view name, uint32_t id, type_kind type, int offset, symbol_kind kind):
+    kind(kind), name(name), id(id), offset(offset), type(type)
 {
 
 }
 
-string variable_symbol::to_string() const
+string symbol::to_string() const
 {
-    stringstream res;
+    string res;
+    append_to(res);
+    return res;
+}
 
-    res << name << " " << types::to_string(type) << " " << offset;
+variable_symbol::variable_symbol(string_view name, uint32_t id, type_kind type, int offset):
+    symbol(name, id, type, offset, symbol_kind::Variable)
+{
 
-    return res.str();
 }
 
-function_symbol::function_symbol(const string& name, type_kind return_type, const vector<type_kind>& parameter_types):
-    symbol(name, return_type, 0, symbol_kind::Function), parameter_types(parameter_types)
+void variable_symbol::append_to(string& out) const
 {
-
+    out.append(name).append(" ").append(types::to_string(type)).append(" ");
+    append_number(out, offset);
 }
 
-string function_symbol::to_string() const
+function_symbol::function_symbol(string_view name, uint32_t id, type_kind return_type, const vector<type_kind>& parameter_types):
+    symbol(name, id, return_type, 0, symbol_kind::Function), parameter_types(parameter_types)
 {
-    stringstream res;
 
-    res << name << " " << "(";
+}
+
+void function_symbol::append_to(string& out) const
+{
+    out.append(name).append(" (");
 
-    for (auto& param : parameter_types)
+    for (size_t i = 0; i < parameter_types.size(); i++)
     {
-        res << types::to_string(param);
+        out.append(types::to_string(parameter_types[i]));
 
-        if (&param != &parameter_types.back())
+        if (i + 1 < parameter_types.size())
         {
-            res << ",";
+            out.append(",");
         }
     }
 
-    res << ")" << "->" << types::to_string(type) << " " << offset;
-
-    return res.str();
-}
\ No newline at end of file
+    out.append(")->").append(types::to_string(type)).append(" ");
+    append_number(out, offset);
+}
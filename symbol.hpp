@@ -2,7 +2,9 @@
 #define _SYMBOL_HPP_
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include <cstdint>
 #include "abstract_syntax.hpp"
 
 enum class symbol_kind { Variable, Function };
@@ -11,40 +13,48 @@ class symbol
 {
     public:
 
-    const symbol_kind kind;
-    const std::string name;
-    const int offset;
-    const type_kind type;
+    // not const, so the symbol_table can reuse a symbol for the next one declared, along with the memory of its name.
+    symbol_kind kind;
+    std::string name;
+
+    // the id of name in the identifier_table of the symbol_table that declared it.
+    std::uint32_t id;
+
+    int offset;
+    type_kind type;
 
     protected:
 
-    symbol(const std::string& name, type_kind type, int offset, symbol_kind kind);
+    symbol(std::string_view name, std::uint32_t id, type_kind type, int offset, symbol_kind kind);
 
     public:
 
     virtual ~symbol() = default;
 
-    virtual std::string to_string() const = 0;
+    // appends the line printed for the symbol in a scope dump, so a caller reusing out allocates nothing once it has grown.
+    virtual void append_to(std::string& out) const = 0;
+
+    std::string to_string() const;
 };
 
 class variable_symbol: public symbol
 {
     public:
 
-    variable_symbol(const std::string& name, type_kind type, int offset);
+    variable_symbol(std::string_view name, std::uint32_t id, type_kind type, int offset);
 
-    std::string to_string() const override;
+    void append_to(std::string& out) const override;
 };
 
 class function_symbol: public symbol
 {
     public:
 
-    const std::vector<type_kind> parameter_types;
+    std::vector<type_kind> parameter_types;
 
-    function_symbol(const std::string& name, type_kind return_type, const std::vector<type_kind>& parameter_types);
+    function_symbol(std::string_view name, std::uint32_t id, type_kind return_type, const std::vector<type_kind>& parameter_types);
 
-    std::string to_string() const override;
+    void append_to(std::string& out) const override;
 };
 
 #endif
\ No newline at end of file
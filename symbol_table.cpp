@@ -1,35 +1,63 @@
 #include "symbol_table.hpp"
 #include "scope.hpp"
+#include <algorithm>
 
 using std::string;
+using std::string_view;
 using std::vector;
-using std::list;
+using std::size_t;
+using std::uint32_t;
 
-symbol_table::symbol_table(): scope_list()
+symbol_table::symbol_table():
+    scope_list(), symbols(), shadowed(), variables(), functions(), variables_used(0), functions_used(0), names(), outermost(), innermost(),
+    shared_globals(nullptr), shared_names(nullptr), visible_globals(0), declared_function(nullptr), lookups(0)
 {
 
 }
 
-symbol_table& symbol_table::instance()
-{
-    static symbol_table instance;
-    return instance;
-}
-
 void symbol_table::open_scope(bool loop_scope)
 {
     if (scope_list.size() == 0)
     {
-        scope_list.push_back(scope(0, loop_scope));
+        scope_list.emplace_back(*this, symbols.size(), 0, 0, loop_scope);
     }
     else
     {
-        scope_list.push_back(scope(scope_list.back().offset, loop_scope));
+        scope_list.emplace_back(*this, symbols.size(), scope_list.back().offset, scope_list.back().loop_depth, loop_scope);
+    }
+}
+
+void symbol_table::release_symbols(size_t first)
+{
+    for (size_t index = symbols.size(); index-- > first;)
+    {
+        const symbol* sym = symbols[index];
+
+        innermost[sym->id] = shadowed[index];
+
+        if (outermost[sym->id] == index)
+        {
+            outermost[sym->id] = scope::none;
+        }
+
+        if (sym->kind == symbol_kind::Function)
+        {
+            functions_used--;
+        }
+        else
+        {
+            variables_used--;
+        }
     }
+
+    symbols.resize(first);
+    shadowed.resize(first);
 }
 
 void symbol_table::close_scope()
 {
+    // the innermost scope holds the last of the symbols.
+    release_symbols(scope_list.back().first);
     scope_list.pop_back();
 }
 
@@ -38,69 +66,252 @@ const scope& symbol_table::current_scope() const
     return scope_list.back();
 }
 
+size_t symbol_table::depth() const
+{
+    return scope_list.size();
+}
+
+size_t symbol_table::loop_depth() const
+{
+    return scope_list.size() != 0 ? scope_list.back().loop_depth : 0;
+}
 
-bool symbol_table::contains_symbol(const string& name) const
+void symbol_table::close_scopes_to(size_t depth)
 {
-    for (const scope& sc : scope_list)
+    while (scope_list.size() > depth)
     {
-        if (sc.contains_symbol(name))
-        {
-            return true;
-        }
+        close_scope();
+    }
+}
+
+void symbol_table::reset(size_t global_symbols)
+{
+    close_scopes_to(1);
+
+    scope& globals = scope_list.front();
+    release_symbols(globals.first + global_symbols);
+    globals.last = symbols.size();
+
+    uint32_t kept_names = 0;
+
+    for (size_t index = globals.first; index < globals.last; index++)
+    {
+        kept_names = std::max(kept_names, symbols[index]->id + 1);
     }
 
-    return false;
+    names.truncate(kept_names);
+    outermost.resize(kept_names);
+    innermost.resize(kept_names);
+
+    shared_globals = nullptr;
+    shared_names = nullptr;
+    visible_globals = 0;
+    declared_function = globals.last != globals.first ? symbols[globals.last - 1] : nullptr;
+    lookups = 0;
+}
+
+void symbol_table::share_globals(const symbol_table& owner, size_t visible)
+{
+    close_scopes_to(0);
+
+    shared_globals = &owner.current_scope();
+    shared_names = &owner.names;
+    visible_globals = visible;
+    declared_function = nullptr;
 }
 
-const symbol* symbol_table::get_symbol(const string& name) const
+uint32_t symbol_table::intern(string_view text)
 {
-    for (const scope& sc : scope_list)
+    uint32_t id = names.intern(text);
+
+    if (id >= outermost.size())
     {
-        if (sc.contains_symbol(name))
-        {
-            return sc.get_symbol(name);
-        }
+        outermost.resize(id + 1, scope::none);
+        innermost.resize(id + 1, scope::none);
     }
 
-    return nullptr;
+    return id;
 }
 
-bool symbol_table::add_variable(const string& name, type_kind type)
+const symbol* symbol_table::current_function() const
 {
-    if (scope_list.size() == 0)
+    return declared_function;
+}
+
+void symbol_table::reject_function()
+{
+    declared_function = nullptr;
+}
+
+const symbol* symbol_table::get_shared_symbol(string_view name) const
+{
+    if (shared_globals == nullptr)
     {
-        return false;
+        return nullptr;
+    }
+
+    uint32_t id = shared_names->find(name);
+
+    if (id == identifier_table::none || shared_globals->contains_symbol(id) == false || shared_globals->position_of(id) >= visible_globals)
+    {
+        return nullptr;
     }
 
-    return scope_list.back().add_variable(name, type);
+    return shared_globals->get_symbol(id);
 }
 
-bool symbol_table::add_parameter(const string& name, type_kind type)
+const symbol* symbol_table::get_shared_symbol(uint32_t id) const
 {
-    if (scope_list.size() == 0)
+    return shared_globals != nullptr ? get_shared_symbol(names.text(id)) : nullptr;
+}
+
+const variable_symbol* symbol_table::new_variable(uint32_t id, type_kind type, int offset)
+{
+    if (variables_used == variables.size())
+    {
+        variables.emplace_back(names.text(id), id, type, offset);
+    }
+    else
+    {
+        variable_symbol& reused = variables[variables_used];
+
+        reused.name.assign(names.text(id));
+        reused.id = id;
+        reused.type = type;
+        reused.offset = offset;
+    }
+
+    return &variables[variables_used++];
+}
+
+const function_symbol* symbol_table::new_function(string_view name, uint32_t id, type_kind return_type, const vector<type_kind>& parameter_types)
+{
+    if (functions_used == functions.size())
+    {
+        functions.emplace_back(name, id, return_type, parameter_types);
+    }
+    else
+    {
+        function_symbol& reused = functions[functions_used];
+
+        reused.name.assign(name);
+        reused.id = id;
+        reused.type = return_type;
+        reused.parameter_types.assign(parameter_types.begin(), parameter_types.end());
+    }
+
+    return &functions[functions_used++];
+}
+
+void symbol_table::push_symbol(const symbol* sym)
+{
+    uint32_t index = static_cast<uint32_t>(symbols.size());
+
+    symbols.push_back(sym);
+    shadowed.push_back(innermost[sym->id]);
+    innermost[sym->id] = index;
+
+    if (outermost[sym->id] == scope::none)
+    {
+        outermost[sym->id] = index;
+    }
+
+    scope_list.back().last++;
+}
+
+const symbol* symbol_table::find_symbol(uint32_t id) const
+{
+    return outermost[id] != scope::none ? symbols[outermost[id]] : get_shared_symbol(id);
+}
+
+size_t symbol_table::lookup_count() const
+{
+    return lookups;
+}
+
+bool symbol_table::contains_symbol(uint32_t id) const
+{
+    lookups++;
+    return find_symbol(id) != nullptr;
+}
+
+const symbol* symbol_table::get_symbol(uint32_t id) const
+{
+    lookups++;
+    return find_symbol(id);
+}
+
+const symbol* symbol_table::get_symbol(string_view name) const
+{
+    lookups++;
+
+    uint32_t id = names.find(name);
+    return id != identifier_table::none ? find_symbol(id) : get_shared_symbol(name);
+}
+
+bool symbol_table::add_variable(uint32_t id, type_kind type)
+{
+    if (scope_list.size() == 0 || scope_list.back().contains_symbol(id))
     {
         return false;
     }
 
-    return scope_list.back().add_parameter(name, type);
+    push_symbol(new_variable(id, type, scope_list.back().offset));
+    scope_list.back().offset += 1;
+    return true;
 }
 
-bool symbol_table::add_function(const string& name, type_kind return_type, const vector<type_kind>& parameter_types)
+bool symbol_table::add_parameter(uint32_t id, type_kind type)
 {
-    if (scope_list.size() == 0)
+    if (scope_list.size() == 0 || scope_list.back().contains_symbol(id))
     {
         return false;
     }
 
-    return scope_list.back().add_function(name, return_type, parameter_types);
+    push_symbol(new_variable(id, type, scope_list.back().param_offset));
+    scope_list.back().param_offset -= 1;
+    return true;
 }
 
-bool symbol_table::add_function(const string& name, type_kind return_type)
+const function_symbol* symbol_table::add_function(string_view name, type_kind return_type, const vector<type_kind>& parameter_types)
 {
-    return add_function(name, return_type, vector<type_kind>());
+    // the owner of the shared globals declared the same functions in the same order.
+    if (scope_list.size() == 0 && shared_globals != nullptr)
+    {
+        uint32_t shared_id = shared_names->find(name);
+
+        if (shared_id != identifier_table::none && shared_globals->contains_symbol(shared_id) && shared_globals->position_of(shared_id) == visible_globals)
+        {
+            const function_symbol* shared = static_cast<const function_symbol*>(shared_globals->get_symbol(shared_id));
+
+            declared_function = shared;
+            visible_globals++;
+            return shared;
+        }
+    }
+
+    if (scope_list.size() == 0)
+    {
+        declared_function = nullptr;
+        return nullptr;
+    }
+
+    uint32_t id = intern(name);
+
+    if (scope_list.back().contains_symbol(id))
+    {
+        declared_function = nullptr;
+        return nullptr;
+    }
+
+    const function_symbol* added = new_function(name, id, return_type, parameter_types);
+
+    declared_function = added;
+    push_symbol(added);
+    return added;
 }
 
-const list<scope>& symbol_table::get_scopes() const
+const function_symbol* symbol_table::add_function(string_view name, type_kind return_type)
 {
-    return scope_list;
+    return add_function(name, return_type, vector<type_kind>());
 }
@@ -2,20 +2,75 @@
 #define _SYMBOL_TABLE_HPP_
 
 #include <string>
-#include <list>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <cstddef>
+#include <cstdint>
 #include "scope.hpp"
+#include "identifier_table.hpp"
 
 class symbol_table
 {
+    friend class scope;
+
     private:
 
-    std::list<scope> scope_list;
+    std::vector<scope> scope_list;
 
-    symbol_table();
+    // the symbols of the open scopes, one scope after another, and for each the index of the symbol with the same name it shadows.
+    // closing a scope only moves the end back, so opening and closing scopes allocates nothing once the vectors have grown.
+    std::vector<const symbol*> symbols;
+    std::vector<std::uint32_t> shadowed;
+
+    // the symbols themselves, of which the first used are in the open scopes. the rest are reused by the next declarations.
+    // a deque never moves its elements, so a symbol stays where it is for as long as its scope is open.
+    std::deque<variable_symbol> variables;
+    std::deque<function_symbol> functions;
+    std::size_t variables_used;
+    std::size_t functions_used;
+
+    // the identifiers of the program, interned as they are lexed.
+    identifier_table names;
+
+    // the index of the symbol each name is bound to in the open scopes, indexed by the id of the name, so a lookup is one load whatever the depth.
+    // names are not shadowed, a name declared again stays bound to the outermost declaration, as a walk from the global scope would find it.
+    // the innermost declaration of each name heads the chain of the symbols it shadows, which the scopes search.
+    std::vector<std::uint32_t> outermost;
+    std::vector<std::uint32_t> innermost;
+
+    // the ids of the shared globals are those of the table that owns them, so names are translated through its identifiers.
+    const scope* shared_globals;
+    const identifier_table* shared_names;
+    std::size_t visible_globals;
+    const symbol* declared_function;
+
+    mutable std::size_t lookups;
+
+    // the symbol of the shared globals named name, if it is among the visible ones.
+    const symbol* get_shared_symbol(std::string_view name) const;
+
+    const symbol* get_shared_symbol(std::uint32_t id) const;
+
+    // get_symbol without counting a lookup.
+    const symbol* find_symbol(std::uint32_t id) const;
+
+    const variable_symbol* new_variable(std::uint32_t id, type_kind type, int offset);
+
+    const function_symbol* new_function(std::string_view name, std::uint32_t id, type_kind return_type, const std::vector<type_kind>& parameter_types);
+
+    // adds sym to the innermost scope and binds it.
+    void push_symbol(const symbol* sym);
+
+    // unbinds the symbols from first on, the last declared first, and gives them back for reuse.
+    void release_symbols(std::size_t first);
 
     public:
 
-    static symbol_table& instance();
+    symbol_table();
+
+    symbol_table(const symbol_table& other) = delete;
+    symbol_table& operator=(const symbol_table& other) = delete;
 
     void open_scope(bool loop_scope = false);
 
@@ -23,19 +78,49 @@ class symbol_table
 
     const scope& current_scope() const;
 
-    bool contains_symbol(const std::string& name) const;
+    std::size_t depth() const;
+
+    // loops around the innermost scope, read off the scope itself rather than counted through the open scopes.
+    std::size_t loop_depth() const;
+
+    // closes scopes until at most depth remain, without printing them. used to drop scopes discarded by error recovery.
+    void close_scopes_to(std::size_t depth);
+
+    // back to the global scope with only its first global_symbols symbols, ready for another program.
+    // those were declared before any other name was interned, so they keep their ids and every other identifier is dropped.
+    void reset(std::size_t global_symbols);
+
+    // drops every scope and makes the first visible symbols of the current scope of owner, which no longer changes, the outermost scope.
+    // declaring a function then reveals the next of them, so a function body is checked against what was declared before it.
+    void share_globals(const symbol_table& owner, std::size_t visible);
+
+    // the id of an identifier, the same for every occurrence of its text until the table is reset.
+    std::uint32_t intern(std::string_view text);
+
+    // the function declared last, whose body is being checked, or nullptr when its declaration was rejected.
+    const symbol* current_function() const;
+
+    // the function being declared was already defined. its body is still checked, but against no function.
+    void reject_function();
+
+    // names resolved through the table since it was created or reset, each call to contains_symbol or get_symbol counts one.
+    std::size_t lookup_count() const;
+
+    bool contains_symbol(std::uint32_t id) const;
 
-    const symbol* get_symbol(const std::string& name) const;
+    const symbol* get_symbol(std::uint32_t id) const;
 
-    bool add_variable(const std::string& name, type_kind type);
+    // for names that were not lexed, which may not have been interned.
+    const symbol* get_symbol(std::string_view name) const;
 
-    bool add_parameter(const std::string& name, type_kind type);
+    bool add_variable(std::uint32_t id, type_kind type);
 
-    bool add_function(const std::string& name, type_kind return_type, const std::vector<type_kind>& parameter_types);
+    bool add_parameter(std::uint32_t id, type_kind type);
 
-    bool add_function(const std::string& name, type_kind return_type);
+    // the function added, or nullptr when the name was already defined.
+    const function_symbol* add_function(std::string_view name, type_kind return_type, const std::vector<type_kind>& parameter_types);
 
-    const std::list<scope>& get_scopes() const;
+    const function_symbol* add_function(std::string_view name, type_kind return_type);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include "syntax_arena.hpp"
+#include <cstdlib>
+#include <cstdint>
+#include <new>
+#include <algorithm>
+#include <sys/mman.h>
+
+using std::size_t;
+using std::uintptr_t;
+
+syntax_arena::syntax_arena(): chunks(), current(0), position(nullptr), limit(nullptr)
+{
+}
+
+syntax_arena::~syntax_arena()
+{
+    for (const chunk& owned : chunks)
+    {
+        if (owned.mapped)
+        {
+            munmap(owned.data, owned.size);
+        }
+        else
+        {
+            std::free(owned.data);
+        }
+    }
+}
+
+void syntax_arena::next_chunk(size_t size)
+{
+    // a kept chunk too small for the allocation stays behind the new one, for the next rewind.
+    if (current == chunks.size() || chunks[current].size < size)
+    {
+        size_t grown = current == 0 ? first_chunk_size : std::min(chunks[current - 1].size * 2, huge_chunk_size);
+        chunk added{ nullptr, std::max(grown, size), false };
+
+        if (added.size >= huge_chunk_size)
+        {
+            added.size = (added.size + huge_chunk_size - 1) / huge_chunk_size * huge_chunk_size;
+            void* mapped = mmap(nullptr, added.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+            if (mapped == MAP_FAILED)
+            {
+                throw std::bad_alloc();
+            }
+
+#ifdef MADV_HUGEPAGE
+            madvise(mapped, added.size, MADV_HUGEPAGE);
+#endif
+
+            added.data = static_cast<char*>(mapped);
+            added.mapped = true;
+        }
+        else
+        {
+            added.data = static_cast<char*>(std::malloc(added.size));
+
+            if (added.data == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+        }
+
+        chunks.insert(chunks.begin() + current, added);
+    }
+
+    position = chunks[current].data;
+    limit = chunks[current].data + chunks[current].size;
+    current++;
+}
+
+void* syntax_arena::allocate(size_t size, size_t alignment)
+{
+    uintptr_t begin = (reinterpret_cast<uintptr_t>(position) + alignment - 1) & ~(alignment - 1);
+
+    if (position == nullptr || begin + size > reinterpret_cast<uintptr_t>(limit))
+    {
+        next_chunk(size + alignment);
+        begin = (reinterpret_cast<uintptr_t>(position) + alignment - 1) & ~(alignment - 1);
+    }
+
+    position = reinterpret_cast<char*>(begin + size);
+    return reinterpret_cast<void*>(begin);
+}
+
+syntax_arena::mark syntax_arena::get_mark() const
+{
+    return { current, position };
+}
+
+void syntax_arena::rewind(const mark& to)
+{
+    current = to.chunk;
+    position = to.position;
+    limit = current != 0 ? chunks[current - 1].data + chunks[current - 1].size : nullptr;
+}
+
+void syntax_arena::clear()
+{
+    rewind({ 0, nullptr });
+}
+
+size_t syntax_arena::used() const
+{
+    size_t total = 0;
+
+    for (size_t i = 0; i + 1 < current; i++)
+    {
+        total += chunks[i].size;
+    }
+
+    return current != 0 ? total + (position - chunks[current - 1].data) : 0;
+}
@@ -0,0 +1,63 @@
+#ifndef _SYNTAX_ARENA_HPP_
+#define _SYNTAX_ARENA_HPP_
+
+#include <vector>
+#include <cstddef>
+
+// bump allocator for the tokens and syntax nodes of one check, created with new (arena) type(...).
+// nodes are never destroyed one by one: clearing or destroying the arena releases all of them at once.
+// chunks grow from 64 KiB to 2 MiB, and the 2 MiB ones are mapped and advised to use transparent huge pages.
+class syntax_arena
+{
+    private:
+
+    struct chunk
+    {
+        char* data;
+        std::size_t size;
+        bool mapped;
+    };
+
+    static constexpr std::size_t first_chunk_size = 64 * 1024;
+    static constexpr std::size_t huge_chunk_size = 2 * 1024 * 1024;
+
+    std::vector<chunk> chunks;
+
+    // chunks in use, the last of them is the one allocated from.
+    std::size_t current;
+    char* position;
+    char* limit;
+
+    // moves on to a chunk with room for size bytes, reusing the chunks kept by a rewind or clear.
+    void next_chunk(std::size_t size);
+
+    public:
+
+    // a point to rewind to, everything allocated after it is released.
+    struct mark
+    {
+        std::size_t chunk;
+        char* position;
+    };
+
+    syntax_arena();
+    ~syntax_arena();
+
+    syntax_arena(const syntax_arena& other) = delete;
+    syntax_arena& operator=(const syntax_arena& other) = delete;
+
+    void* allocate(std::size_t size, std::size_t alignment);
+
+    mark get_mark() const;
+
+    // releases everything allocated after the mark, keeping the chunks for what is allocated next.
+    void rewind(const mark& to);
+
+    // releases everything, keeping the chunks for the next check.
+    void clear();
+
+    // bytes from the start of the first chunk to the position, counting the unused ends of the chunks before it.
+    std::size_t used() const;
+};
+
+#endif
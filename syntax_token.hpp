@@ -1,21 +1,39 @@
-
 #ifndef _SYNTAX_TOKEN_HPP_
 #define _SYNTAX_TOKEN_HPP_
 
-#include <string>
+#include "syntax_arena.hpp"
+#include "identifier_table.hpp"
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
 
+// text is a view into the source buffer, which outlives every token of the check.
+// the line of a token is only looked up from its offset when a diagnostic needs it.
+// tokens are allocated from the arena of the check, and released with it.
 class syntax_token
 {
     public:
 
     const int type;
-    const int position;
-    const std::string text;
+    const std::uint32_t offset;
+    const std::string_view text;
+
+    // the interned id of an identifier, set as the token is handed to the parser. none for every other token.
+    std::uint32_t id;
+
+    syntax_token(int type, std::uint32_t offset, std::string_view text):
+        type(type), offset(offset), text(text), id(identifier_table::none)
+    {
 
-    syntax_token(int type, int position, const std::string& text):
-        type(type), position(position), text(text)
+    }
+
+    static void* operator new(std::size_t size, syntax_arena& arena)
     {
+        return arena.allocate(size, alignof(syntax_token));
+    }
 
+    static void operator delete(void*, syntax_arena&)
+    {
     }
 };
 
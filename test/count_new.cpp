@@ -0,0 +1,49 @@
+#include <atomic>
+#include <new>
+#include <cstdio>
+#include <cstdlib>
+#include <cstddef>
+
+using std::size_t;
+
+// linked into a build of the checker, replaces the global operator new and reports how many times it was called as the program exits.
+// the array forms and the nothrow forms all end up in the plain operator new, so every allocation through new is counted once.
+
+static std::atomic<size_t> allocations(0);
+
+void* operator new(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+
+    void* memory = std::malloc(size != 0 ? size : 1);
+
+    if (memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace
+{
+    struct allocation_report
+    {
+        ~allocation_report()
+        {
+            std::fprintf(stderr, "allocations: %zu\n", allocations.load());
+        }
+    };
+
+    allocation_report report;
+}
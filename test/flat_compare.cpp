@@ -0,0 +1,110 @@
+#include "parser.tab.hpp"
+#include "checker_context.hpp"
+#include "source_buffer.hpp"
+#include "flat_syntax.hpp"
+#include "output.hpp"
+#include <iostream>
+#include <exception>
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+using std::uint32_t;
+using std::vector;
+
+// checks each file, and compares the flat lowering of its syntax with the linked tree: the same kinds, in the same shape,
+// with the same expression types. files whose check stops at an error have no complete tree and are skipped.
+
+static bool compare(const syntax_base& root, const flat_syntax& flat)
+{
+    vector<std::pair<const syntax_base*, uint32_t>> pending{ { &root, 0 } };
+
+    while (pending.empty() == false)
+    {
+        auto [linked, index] = pending.back();
+        pending.pop_back();
+
+        const flat_syntax::node& node = flat.at(index);
+
+        if (node.kind != linked->node_kind)
+        {
+            return false;
+        }
+
+        if (node.kind >= syntax_kind::Literal && flat.type_of(node) != static_cast<const expression_syntax*>(linked)->return_type)
+        {
+            return false;
+        }
+
+        uint32_t child = node.first_child;
+
+        for (const syntax_base* linked_child : linked->get_children())
+        {
+            if (child == flat_syntax::none)
+            {
+                return false;
+            }
+
+            pending.emplace_back(linked_child, child);
+            child = flat.at(child).next_sibling;
+        }
+
+        if (child != flat_syntax::none)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: flat_compare FILE..." << std::endl;
+        return 1;
+    }
+
+    std::ostream discard(nullptr);
+    output::set_stream(discard);
+
+    int compared = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        source_buffer source(argv[i]);
+        checker_context context(source, lexer_kind::Hand);
+
+        try
+        {
+            context.open_global_scope();
+
+            if (yyparse(context) != 0 || context.root == nullptr)
+            {
+                continue;
+            }
+        }
+        catch (const output::check_aborted&)
+        {
+            continue;
+        }
+        catch (const std::exception&)
+        {
+            continue;
+        }
+
+        flat_syntax flat(*context.root);
+
+        if (compare(*context.root, flat) == false)
+        {
+            std::cout << argv[i] << ": the flat lowering differs from the linked tree" << std::endl;
+            return 1;
+        }
+
+        compared++;
+    }
+
+    std::cout << "the flat lowering matches the linked tree on " << compared << " files" << std::endl;
+    return 0;
+}
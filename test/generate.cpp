@@ -0,0 +1,237 @@
+#include <iostream>
+#include <string_view>
+#include <cstdlib>
+#include <cstddef>
+
+using std::size_t;
+using std::string_view;
+
+// writes the programs the tests and benchmarks check, all of them free of errors.
+
+static std::ostream& out = std::cout;
+
+static void repeat(string_view text, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        out << text;
+    }
+}
+
+// count calls, with declarations and expressions around them, in blocks of 250 calls that declare the same few names.
+static void calls(size_t count)
+{
+    out << "void main()\n{\n";
+
+    for (size_t done = 0; done < count;)
+    {
+        out << "    {\n        int x = 1;\n        byte y = 2b;\n        bool c = true;\n";
+
+        for (size_t i = 0; i < 125 && done < count; i++, done += 2)
+        {
+            out << "        x = x + y * (x - 3);\n";
+            out << "        c = c and x > 1 or not c;\n";
+            out << "        printi(x + (y * 2));\n";
+            out << "        print(\"call\");\n";
+        }
+
+        out << "    }\n";
+    }
+
+    out << "}\n";
+}
+
+// count functions, each with parameters and a loop block, all different names.
+static void functions(size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        out << "int f" << i << "(int a, byte c)\n{\n";
+        out << "    while (a > 0)\n    {\n        int d = a;\n        a = a - d + c;\n        if (a == 3)\n        {\n            break;\n        }\n    }\n";
+        out << "    return a + c;\n}\n";
+    }
+
+    out << "void main()\n{\n    printi(f0(1, 2b));\n}\n";
+}
+
+// blocks nested count deep, around a single call.
+static void blocks(size_t count)
+{
+    out << "void main()\n{\n";
+    repeat("{\n", count);
+    out << "printi(1);\n";
+    repeat("}\n", count);
+    out << "}\n";
+}
+
+// loops nested count deep.
+static void loops(size_t count)
+{
+    out << "void main()\n{\nint i = 0;\n";
+    repeat("while (i < 1)\n{\n", count);
+    out << "i = 1;\n";
+    repeat("}\n", count);
+    out << "}\n";
+}
+
+// count blocks nested in a loop, each holding a break.
+static void breaks(size_t count)
+{
+    out << "void main()\n{\nwhile (true)\n{\n";
+    repeat("{\nbreak;\n", count);
+    repeat("}\n", count);
+    out << "}\n}\n";
+}
+
+// an argument in count parentheses.
+static void parens(size_t count)
+{
+    out << "void main()\n{\nprinti(";
+    repeat("(", count);
+    out << "1";
+    repeat(")", count);
+    out << ");\n}\n";
+}
+
+// 1 + (1 + (...)), nested count deep to the right.
+static void chain(size_t count)
+{
+    out << "void main()\n{\nprinti(";
+    repeat("1 + (", count);
+    out << "1";
+    repeat(")", count);
+    out << ");\n}\n";
+}
+
+// count nots in a row.
+static void nots(size_t count)
+{
+    out << "void main()\n{\nbool x = ";
+    repeat("not ", count);
+    out << "true;\n}\n";
+}
+
+// count statements using x and y, declared in the innermost of depth blocks.
+static void lookups(size_t depth, size_t count)
+{
+    size_t inner = depth > 0 ? depth - 1 : 0;
+
+    out << "void main()\n{\n";
+    repeat("{\n", inner);
+    out << "int x = 0;\nint y = 1;\n";
+    repeat("x = x + y;\n", count);
+    repeat("}\n", inner);
+    out << "}\n";
+}
+
+// a function of count parameters, and a call passing it count arguments.
+static void arguments(size_t count)
+{
+    out << "int sum(";
+
+    for (size_t i = 0; i < count; i++)
+    {
+        out << (i == 0 ? "" : ", ") << "int a" << i;
+    }
+
+    out << ")\n{\n    return a0;\n}\n\nvoid main()\n{\n    printi(sum(";
+
+    for (size_t i = 0; i < count; i++)
+    {
+        out << (i == 0 ? "" : ", ") << i;
+    }
+
+    out << "));\n}\n";
+}
+
+// count lines, most of them comments.
+static void comments(size_t count)
+{
+    out << "void main()\n{\n    int x = 0;\n";
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (i % 4 == 3)
+        {
+            out << "    x = x + 1; // counts the lines of comments above it, which is what the line is for\n";
+        }
+        else
+        {
+            out << "    // a comment line as long as a descriptive one in real code would be, with nothing else on it\n";
+        }
+    }
+
+    out << "}\n";
+}
+
+// count lines of dense code, with little whitespace and no comments.
+static void code(size_t count)
+{
+    out << "void main()\n{\nint x = 0;\nbyte y = 2b;\nbool c = false;\n";
+
+    for (size_t i = 0; i < count; i++)
+    {
+        out << "x = x * (y + 3) - x / 2; c = not c and x > y or x == 7; if (c) printi(x); else print(\"s\");\n";
+    }
+
+    out << "}\n";
+}
+
+// count lines, each printing a long string literal and counting it in a long name.
+static void strings(size_t count)
+{
+    out << "void main()\n{\n    int printedmessagecount = 0;\n";
+
+    for (size_t i = 0; i < count; i++)
+    {
+        out << "    print(\"a message as long as one shown to a user would be, with \\\"quotes\\\" now and then\");";
+        out << " printedmessagecount = printedmessagecount + 1;\n";
+    }
+
+    out << "}\n";
+}
+
+static size_t argument(int argc, char** argv, int index)
+{
+    if (index >= argc)
+    {
+        std::cerr << "missing count for " << argv[1] << std::endl;
+        std::exit(1);
+    }
+
+    return std::strtoull(argv[index], nullptr, 10);
+}
+
+int main(int argc, char** argv)
+{
+    std::ios::sync_with_stdio(false);
+
+    if (argc < 2)
+    {
+        std::cerr << "usage: generate calls|functions|arguments|blocks|loops|breaks|parens|chain|nots|comments|code|strings COUNT, or generate lookups DEPTH COUNT" << std::endl;
+        return 1;
+    }
+
+    string_view mode = argv[1];
+
+    if (mode == "calls") calls(argument(argc, argv, 2));
+    else if (mode == "functions") functions(argument(argc, argv, 2));
+    else if (mode == "arguments") arguments(argument(argc, argv, 2));
+    else if (mode == "blocks") blocks(argument(argc, argv, 2));
+    else if (mode == "loops") loops(argument(argc, argv, 2));
+    else if (mode == "breaks") breaks(argument(argc, argv, 2));
+    else if (mode == "parens") parens(argument(argc, argv, 2));
+    else if (mode == "chain") chain(argument(argc, argv, 2));
+    else if (mode == "nots") nots(argument(argc, argv, 2));
+    else if (mode == "comments") comments(argument(argc, argv, 2));
+    else if (mode == "code") code(argument(argc, argv, 2));
+    else if (mode == "strings") strings(argument(argc, argv, 2));
+    else if (mode == "lookups") lookups(argument(argc, argv, 2), argument(argc, argv, 3));
+    else
+    {
+        std::cerr << "unknown mode " << mode << std::endl;
+        return 1;
+    }
+
+    return out.flush() ? 0 : 1;
+}
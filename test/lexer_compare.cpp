@@ -0,0 +1,230 @@
+#include "parser.tab.hpp"
+#include "checker_context.hpp"
+#include "source_buffer.hpp"
+#include "syntax_token.hpp"
+#include "source_index.hpp"
+#include "output.hpp"
+#include <iostream>
+#include <string_view>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+using std::size_t;
+using std::string_view;
+
+// prints the tokens one lexer hands the parser, a line each, so the test compares what two lexers print for the same file.
+// lexical errors are printed as the checker prints them, and lexing goes on past them as it does with --max-errors.
+// with --bench, measures how fast each lexer lexes a file instead, and how fast the source index scans it.
+// the -scalar lexers use the source index with its vector scan switched off.
+
+using scan_kind = source_index::scan_kind;
+
+struct lexer_entry
+{
+    lexer_kind kind;
+    scan_kind scan;
+    const char* name;
+};
+
+static const lexer_entry lexers[] =
+{
+    { lexer_kind::Flex, scan_kind::Vector, "flex" },
+    { lexer_kind::Hand, scan_kind::Vector, "hand" },
+    { lexer_kind::Buffered, scan_kind::Vector, "buffered" },
+    { lexer_kind::Hand, scan_kind::Scalar, "hand-scalar" },
+    { lexer_kind::Buffered, scan_kind::Scalar, "buffered-scalar" },
+};
+
+static const char* scan_name(scan_kind scan)
+{
+    return scan == scan_kind::Vector ? "vector" : "scalar";
+}
+
+// lexes source up to and including END, printing each token when print is set.
+static size_t lex(source_buffer& source, lexer_kind kind, bool print)
+{
+    checker_context context(source, kind);
+    size_t count = 0;
+
+    while (true)
+    {
+        YYSTYPE value;
+        value.token = nullptr;
+
+        int token_kind = context.next_token(&value);
+        count++;
+
+        // the line is the one a syntax error at the token reports. the punctuation tokens carry no syntax_token.
+        if (print)
+        {
+            std::cout << token_kind << " line " << context.current_line();
+
+            if (value.token != nullptr)
+            {
+                std::cout << " at " << value.token->offset << " '" << value.token->text << "'";
+            }
+
+            std::cout << '\n';
+        }
+
+        if (token_kind == END)
+        {
+            return count;
+        }
+    }
+}
+
+// time stamp counter ticks, which run at the nominal clock rate of the processor. 0 where there is no such counter.
+static std::uint64_t cycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+struct timing
+{
+    double seconds;
+    std::uint64_t cycles;
+};
+
+// the fastest of a few runs of work, which returns what it counted.
+template<typename work_function> timing best_of(work_function work, size_t& count)
+{
+    constexpr int rounds = 5;
+
+    timing best{ 0, 0 };
+
+    for (int round = 0; round < rounds; round++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::uint64_t start_cycles = cycles();
+
+        count = work();
+
+        std::uint64_t elapsed_cycles = cycles() - start_cycles;
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        if (round == 0 || elapsed.count() < best.seconds)
+        {
+            best = { elapsed.count(), elapsed_cycles };
+        }
+    }
+
+    return best;
+}
+
+static void print_rate(const source_buffer& source, timing best)
+{
+    std::cout << source.size() / best.seconds / 1e6 << " MB/s";
+
+    if (best.cycles != 0)
+    {
+        std::cout << ", " << static_cast<double>(source.size()) / best.cycles << " bytes/cycle";
+    }
+
+    std::cout << std::endl;
+}
+
+// the passes of the source index alone: the newline index built for every check, and the comment scan run over the whole file.
+static void bench_index(const char* path, const source_buffer& source)
+{
+    const char* begin = source.data();
+    const char* end = begin + source.size();
+
+    for (scan_kind scan : { scan_kind::Vector, scan_kind::Scalar })
+    {
+        source_index::set_scan(scan);
+        size_t count = 0;
+
+        timing newlines = best_of([&] { return source_index(source).get_newlines().size(); }, count);
+        std::cout << path << ": " << scan_name(scan) << " newline index, " << count << " lines in " << newlines.seconds * 1000 << " ms, ";
+        print_rate(source, newlines);
+
+        timing line_breaks = best_of([&]
+        {
+            size_t found = 0;
+
+            for (const char* position = begin; position != end; found++)
+            {
+                position = source_index::find_line_break(begin, end, position);
+                position += position != end;
+            }
+
+            return found;
+        }, count);
+
+        std::cout << path << ": " << scan_name(scan) << " line breaks, " << count << " lines in " << line_breaks.seconds * 1000 << " ms, ";
+        print_rate(source, line_breaks);
+    }
+}
+
+static void bench(const char* path)
+{
+    source_buffer source(path);
+
+    for (const lexer_entry& entry : lexers)
+    {
+        source_index::set_scan(entry.scan);
+        size_t count = 0;
+
+        timing best = best_of([&] { return lex(source, entry.kind, false); }, count);
+
+        std::cout << path << ": " << entry.name << " " << count << " tokens in " << best.seconds * 1000 << " ms, "
+            << count / best.seconds / 1e6 << " Mtokens/s, ";
+        print_rate(source, best);
+    }
+
+    bench_index(path, source);
+    source_index::set_scan(scan_kind::Vector);
+}
+
+static const lexer_entry* find_lexer(string_view name)
+{
+    for (const lexer_entry& entry : lexers)
+    {
+        if (entry.name == name)
+        {
+            return &entry;
+        }
+    }
+
+    return nullptr;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 2 && string_view(argv[1]) == "--bench")
+    {
+        for (int i = 2; i < argc; i++)
+        {
+            bench(argv[i]);
+        }
+
+        return 0;
+    }
+
+    const lexer_entry* entry = argc == 3 ? find_lexer(argv[1]) : nullptr;
+
+    if (entry == nullptr)
+    {
+        std::cerr << "usage: lexer_compare flex|hand|buffered|hand-scalar|buffered-scalar FILE, or lexer_compare --bench FILE..." << std::endl;
+        return 1;
+    }
+
+    output::set_max_errors(SIZE_MAX);
+
+    source_index::set_scan(entry->scan);
+
+    source_buffer source(argv[2]);
+    lex(source, entry->kind, true);
+
+    return std::cout.flush() ? 0 : 1;
+}
@@ -0,0 +1,146 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <chrono>
+#include <cstdlib>
+#include <cstddef>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+using std::size_t;
+using std::string;
+using std::string_view;
+
+// runs a command a few times with its output discarded, and reports the best wall time and the largest peak resident size.
+// with --stack, the command runs with that much native stack, to show that deep inputs do not depend on it.
+// with --input, the command reads that file on its standard input.
+
+struct run_result
+{
+    double seconds;
+    long peak_kilobytes;
+    int status;
+};
+
+static run_result run(char** command, long stack_kilobytes, const char* input)
+{
+    auto start = std::chrono::steady_clock::now();
+    pid_t child = fork();
+
+    if (child < 0)
+    {
+        return { 0, 0, -1 };
+    }
+
+    if (child == 0)
+    {
+        if (stack_kilobytes > 0)
+        {
+            rlimit limit{ static_cast<rlim_t>(stack_kilobytes) * 1024, static_cast<rlim_t>(stack_kilobytes) * 1024 };
+            setrlimit(RLIMIT_STACK, &limit);
+        }
+
+        if (input != nullptr)
+        {
+            int source = open(input, O_RDONLY);
+
+            if (source < 0)
+            {
+                _exit(126);
+            }
+
+            dup2(source, STDIN_FILENO);
+        }
+
+        int discard = open("/dev/null", O_WRONLY);
+        dup2(discard, STDOUT_FILENO);
+        execvp(command[0], command);
+        _exit(127);
+    }
+
+    int status;
+    rusage usage;
+
+    wait4(child, &status, 0, &usage);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    return { elapsed.count(), usage.ru_maxrss, WIFEXITED(status) ? WEXITSTATUS(status) : -1 };
+}
+
+int main(int argc, char** argv)
+{
+    int rounds = 3;
+    long stack_kilobytes = 0;
+    const char* input = nullptr;
+    int first = 1;
+
+    while (first + 1 < argc && argv[first][0] == '-')
+    {
+        if (string_view(argv[first]) == "--rounds")
+        {
+            rounds = std::atoi(argv[first + 1]);
+        }
+        else if (string_view(argv[first]) == "--stack")
+        {
+            stack_kilobytes = std::atol(argv[first + 1]);
+        }
+        else if (string_view(argv[first]) == "--input")
+        {
+            input = argv[first + 1];
+        }
+        else
+        {
+            break;
+        }
+
+        first += 2;
+    }
+
+    if (first >= argc || rounds < 1)
+    {
+        std::cerr << "usage: measure [--rounds N] [--stack KB] [--input FILE] COMMAND ARGS..." << std::endl;
+        return 1;
+    }
+
+    string name;
+
+    for (int i = first; i < argc; i++)
+    {
+        name += i == first ? "" : " ";
+        name += argv[i];
+    }
+
+    if (input != nullptr)
+    {
+        name += " < ";
+        name += input;
+    }
+
+    run_result best{ 0, 0, 0 };
+
+    for (int round = 0; round < rounds; round++)
+    {
+        run_result result = run(argv + first, stack_kilobytes, input);
+
+        if (result.status != 0)
+        {
+            std::cout << name << ": exit status " << result.status << std::endl;
+            return 1;
+        }
+
+        if (round == 0 || result.seconds < best.seconds)
+        {
+            best.seconds = result.seconds;
+        }
+
+        if (result.peak_kilobytes > best.peak_kilobytes)
+        {
+            best.peak_kilobytes = result.peak_kilobytes;
+        }
+    }
+
+    std::cout << name << ": " << best.seconds * 1000 << " ms, peak " << best.peak_kilobytes / 1024 << " MB" << std::endl;
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include "socket_frames.hpp"
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using std::string;
+
+// sends each file to a check server over one connection, and prints the answers one after another.
+// the test compares them with what checking each file on the command line prints.
+
+static int connect_server(const char* path)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+
+    if (std::strlen(path) >= sizeof(address.sun_path))
+    {
+        return -1;
+    }
+
+    std::strcpy(address.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    if (fd >= 0 && connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::cerr << "usage: server_client SOCKET FILE..." << std::endl;
+        return 1;
+    }
+
+    int fd = connect_server(argv[1]);
+
+    if (fd < 0)
+    {
+        std::cerr << "cannot connect to " << argv[1] << std::endl;
+        return 1;
+    }
+
+    for (int i = 2; i < argc; i++)
+    {
+        std::ifstream in(argv[i], std::ios::binary);
+        string program((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        string answer;
+
+        if (in.is_open() == false || socket_frames::write(fd, program) == false || socket_frames::read(fd, answer) == false)
+        {
+            std::cerr << argv[i] << ": no answer" << std::endl;
+            close(fd);
+            return 1;
+        }
+
+        std::cout << answer;
+    }
+
+    close(fd);
+
+    return std::cout.flush() ? 0 : 1;
+}
@@ -0,0 +1,56 @@
+#include "stream_checker.hpp"
+#include "checker_context.hpp"
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <algorithm>
+#include <cstdlib>
+#include <cstddef>
+
+using std::size_t;
+using std::string;
+
+// checks a file as --stream does, feeding it to the checker a fixed number of bytes at a time.
+// a pipe rarely hands over chunks of one or a few bytes, so this is how the test splits tokens at every possible point.
+
+int main(int argc, char** argv)
+{
+    size_t size = argc == 3 ? std::strtoull(argv[1], nullptr, 10) : 0;
+
+    if (size == 0)
+    {
+        std::cerr << "usage: stream_chunks SIZE FILE" << std::endl;
+        return 1;
+    }
+
+    std::ifstream in(argv[2], std::ios::binary);
+
+    if (in.is_open() == false)
+    {
+        std::cerr << "cannot open " << argv[2] << std::endl;
+        return 1;
+    }
+
+    string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    stream_checker checker(check_options(), std::cout);
+
+    for (size_t offset = 0; offset < text.size(); offset += size)
+    {
+        if (checker.feed(text.data() + offset, std::min(size, text.size() - offset)) == false)
+        {
+            break;
+        }
+    }
+
+    checker.finish();
+
+    if (checker.get_failure().empty() == false)
+    {
+        std::cerr << checker.get_failure() << std::endl;
+        return 1;
+    }
+
+    return std::cout.flush() ? 0 : 1;
+}
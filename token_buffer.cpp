@@ -0,0 +1,113 @@
+#include "token_buffer.hpp"
+#include "syntax_token.hpp"
+#include <string_view>
+
+using std::size_t;
+using std::uint8_t;
+using std::uint32_t;
+
+// token kinds are END (0) or a contiguous range starting at YYerror (256), stored shifted into a byte.
+static_assert(NOT - YYerror + 1 <= UINT8_MAX, "token kinds do not fit in a byte");
+
+static uint8_t encode_kind(yytoken_kind_t kind)
+{
+    return kind == END ? 0 : static_cast<uint8_t>(kind - YYerror + 1);
+}
+
+static yytoken_kind_t decode_kind(uint8_t kind)
+{
+    return kind == 0 ? END : static_cast<yytoken_kind_t>(kind + YYerror - 1);
+}
+
+token_buffer::token_buffer(const source_buffer& source):
+    source(source.data()), kinds(), offsets(), lengths()
+{
+}
+
+void token_buffer::push_back(yytoken_kind_t kind, uint32_t offset, uint32_t length)
+{
+    kinds.push_back(encode_kind(kind));
+    offsets.push_back(offset);
+    lengths.push_back(length);
+}
+
+size_t token_buffer::size() const
+{
+    return kinds.size();
+}
+
+yytoken_kind_t token_buffer::kind(size_t index) const
+{
+    return decode_kind(kinds[index]);
+}
+
+uint32_t token_buffer::offset(size_t index) const
+{
+    return offsets[index];
+}
+
+uint32_t token_buffer::length(size_t index) const
+{
+    return lengths[index];
+}
+
+std::string_view token_buffer::text(size_t index) const
+{
+    return std::string_view(source + offsets[index], lengths[index]);
+}
+
+bool token_buffer::carries_text(yytoken_kind_t kind)
+{
+    switch (kind)
+    {
+        case END:
+        case YYUNDEF:
+        case SC:
+        case COMMA:
+        case LPAREN:
+        case RPAREN:
+        case LBRACE:
+        case RBRACE: return false;
+
+        default: return true;
+    }
+}
+
+token_reader::token_reader(const token_buffer& tokens):
+    tokens(tokens), cursor(0), last(tokens.size() - 1), end_offset(tokens.offset(tokens.size() - 1)), read_offset(0)
+{
+}
+
+void token_reader::select(size_t first, size_t last, uint32_t end_offset)
+{
+    cursor = first;
+    this->last = last;
+    this->end_offset = end_offset;
+}
+
+yytoken_kind_t token_reader::next(YYSTYPE* value, syntax_arena& arena)
+{
+    // END keeps being returned once reached.
+    if (cursor == last)
+    {
+        read_offset = end_offset;
+        return END;
+    }
+
+    yytoken_kind_t kind = tokens.kind(cursor);
+
+    if (token_buffer::carries_text(kind))
+    {
+        value->token = new (arena) syntax_token(kind, tokens.offset(cursor), tokens.text(cursor));
+    }
+
+    read_offset = tokens.offset(cursor);
+    cursor++;
+
+    return kind;
+}
+
+uint32_t token_reader::last_offset() const
+{
+    return read_offset;
+}
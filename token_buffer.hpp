@@ -0,0 +1,70 @@
+#ifndef _TOKEN_BUFFER_HPP_
+#define _TOKEN_BUFFER_HPP_
+
+#include "parser.tab.hpp"
+#include "source_buffer.hpp"
+#include <vector>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+
+// token stream of a whole source, stored as parallel arrays of kind, byte offset and length (9 bytes per token).
+// lines are not tracked, they are recovered from the offset when a diagnostic needs them.
+class token_buffer
+{
+    private:
+
+    const char* const source;
+    std::vector<std::uint8_t> kinds;
+    std::vector<std::uint32_t> offsets;
+    std::vector<std::uint32_t> lengths;
+
+    public:
+
+    token_buffer(const source_buffer& source);
+
+    token_buffer(const token_buffer& other) = delete;
+    token_buffer& operator=(const token_buffer& other) = delete;
+
+    void push_back(yytoken_kind_t kind, std::uint32_t offset, std::uint32_t length);
+
+    std::size_t size() const;
+
+    yytoken_kind_t kind(std::size_t index) const;
+    std::uint32_t offset(std::size_t index) const;
+    std::uint32_t length(std::size_t index) const;
+    std::string_view text(std::size_t index) const;
+
+    // false for punctuation, which the parser never reads a value of.
+    static bool carries_text(yytoken_kind_t kind);
+};
+
+// hands the tokens of a range of a token_buffer to the parser one at a time, like a lexer would, and END after the last of them.
+// the buffer is only read, so checks on several threads may each read their own range of the same one.
+class token_reader
+{
+    private:
+
+    const token_buffer& tokens;
+    std::size_t cursor;
+    std::size_t last;
+    std::uint32_t end_offset;
+    std::uint32_t read_offset;
+
+    public:
+
+    // the whole buffer, up to the END it ends with.
+    token_reader(const token_buffer& tokens);
+
+    token_reader(const token_reader& other) = delete;
+    token_reader& operator=(const token_reader& other) = delete;
+
+    // reads the tokens [first, last) next, and then END at end_offset.
+    void select(std::size_t first, std::size_t last, std::uint32_t end_offset);
+
+    yytoken_kind_t next(YYSTYPE* value, syntax_arena& arena);
+
+    std::uint32_t last_offset() const;
+};
+
+#endif
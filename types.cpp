@@ -1,94 +1,38 @@
 #include "types.hpp"
 #include <stdexcept>
 
-using std::string;
+using std::size_t;
+using std::string_view;
 
-string types::to_string(type_kind type)
+static constexpr bool lattice_in_order()
 {
-    switch (type)
+    for (size_t i = 0; i < types::type_count; i++)
     {
-        case (type_kind::Bool): return "BOOL";
-        case (type_kind::Int): return "INT";
-        case (type_kind::Byte): return "BYTE";
-        case (type_kind::String): return "STRING";
-        case (type_kind::Void): return "VOID";
-
-        default: throw std::invalid_argument("unknown type");
+        if (types::index(types::lattice[i].kind) != i)
+        {
+            return false;
+        }
     }
-}
 
-type_kind types::parse(const string& str)
-{
-    if (str == "bool") return type_kind::Bool;
-    if (str == "int") return type_kind::Int;
-    if (str == "byte") return type_kind::Byte;
-    if (str == "string") return type_kind::String;
-    if (str == "void") return type_kind::Void;
-
-    throw std::invalid_argument("can't parse str");
+    return true;
 }
 
-bool types::is_implictly_convertible(type_kind from, type_kind to)
-{
-    if (from == type_kind::Invalid || to == type_kind::Invalid)
-    {
-        return false;
-    }
+static_assert(lattice_in_order(), "the rows of the lattice must be in the order of type_kind.");
 
-    if (from == type_kind::Void || to == type_kind::Void)
-    {
-        return false;
-    }
-
-    if (from == to)
-    {
-        return true;
-    }
-
-    if (from == type_kind::Byte && to == type_kind::Int)
-    {
-        return true;
-    }
-
-    return false;
-}
+static_assert(types::is_implictly_convertible(type_kind::Byte, type_kind::Int));
+static_assert(types::is_implictly_convertible(type_kind::Int, type_kind::Byte) == false);
+static_assert(types::is_implictly_convertible(type_kind::Void, type_kind::Void) == false);
+static_assert(types::cast_up(type_kind::Int, type_kind::Byte) == type_kind::Int);
+static_assert(types::cast_up(type_kind::Bool, type_kind::Int) == type_kind::Invalid);
 
-type_kind types::cast_up(type_kind first, type_kind second)
+string_view types::to_string(type_kind type)
 {
-    if (first == type_kind::Invalid || second == type_kind::Invalid)
-    {
-        return type_kind::Invalid;
-    }
-
-    if (first == type_kind::Void || second == type_kind::Void)
-    {
-        return type_kind::Invalid;
-    }
-
-    if (first == second)
-    {
-        return first;
-    }
+    string_view name = lattice[index(type)].name;
 
-    if (first == type_kind::Int && second == type_kind::Byte)
+    if (name.empty())
     {
-        return type_kind::Int;
+        throw std::invalid_argument("unknown type");
     }
 
-    if (first == type_kind::Byte && second == type_kind::Int)
-    {
-        return type_kind::Int;
-    }
-
-    return type_kind::Invalid;
-}
-
-bool types::is_numeric(type_kind type)
-{
-    return type == type_kind::Int || type == type_kind::Byte;
+    return name;
 }
-
-bool types::is_special(type_kind type)
-{
-    return type == type_kind::Invalid || type == type_kind::Void || type == type_kind::String;
-}
\ No newline at end of file
@@ -1,23 +1,130 @@
 #ifndef _TYPES_H_
 #define _TYPES_H_
 
-#include <string>
+#include <array>
+#include <iterator>
+#include <string_view>
+#include <cstddef>
 
 enum class type_kind { Invalid, Void, Int, Bool, Byte, String };
 
 namespace types
 {
-    std::string to_string(type_kind type);
+    struct type_info
+    {
+        type_kind kind;
 
-    type_kind parse(const std::string& str);
+        // as diagnostics print it, empty for a type that is never printed.
+        std::string_view name;
 
-    bool is_implictly_convertible(type_kind from, type_kind to);
+        // whether an expression of the type holds a value, which is what every conversion needs.
+        bool has_value;
+        bool numeric;
+        bool special;
+    };
 
-    bool is_numeric(type_kind type);
+    struct widening
+    {
+        type_kind from;
+        type_kind to;
+    };
 
-    bool is_special(type_kind type);
+    // the type lattice. the tables below are generated from these two at compile time, so a type or a conversion is added here only.
+    // rows are in the order of type_kind.
+    constexpr type_info lattice[] =
+    {
+        { type_kind::Invalid, "",       false, false, true  },
+        { type_kind::Void,    "VOID",   false, false, true  },
+        { type_kind::Int,     "INT",    true,  true,  false },
+        { type_kind::Bool,    "BOOL",   true,  false, false },
+        { type_kind::Byte,    "BYTE",   true,  true,  false },
+        { type_kind::String,  "STRING", true,  false, true  },
+    };
 
-    type_kind cast_up(type_kind first, type_kind second);
+    // implicit conversions, besides that of every type with a value to itself.
+    constexpr widening widenings[] =
+    {
+        { type_kind::Byte, type_kind::Int },
+    };
+
+    constexpr std::size_t type_count = std::size(lattice);
+
+    template<typename element_type> using type_table = std::array<std::array<element_type, type_count>, type_count>;
+
+    constexpr std::size_t index(type_kind type)
+    {
+        return static_cast<std::size_t>(type);
+    }
+
+    constexpr type_table<bool> make_conversions()
+    {
+        type_table<bool> table{};
+
+        for (const type_info& type : lattice)
+        {
+            table[index(type.kind)][index(type.kind)] = type.has_value;
+        }
+
+        for (const widening& conversion : widenings)
+        {
+            table[index(conversion.from)][index(conversion.to)] = lattice[index(conversion.from)].has_value && lattice[index(conversion.to)].has_value;
+        }
+
+        return table;
+    }
+
+    inline constexpr type_table<bool> conversions = make_conversions();
+
+    // the type both convert to, the one of them the other widens to, or Invalid when there is none.
+    constexpr type_table<type_kind> make_joins()
+    {
+        type_table<type_kind> table{};
+
+        for (std::size_t first = 0; first < type_count; first++)
+        {
+            for (std::size_t second = 0; second < type_count; second++)
+            {
+                if (conversions[first][second])
+                {
+                    table[first][second] = static_cast<type_kind>(second);
+                }
+                else if (conversions[second][first])
+                {
+                    table[first][second] = static_cast<type_kind>(first);
+                }
+                else
+                {
+                    table[first][second] = type_kind::Invalid;
+                }
+            }
+        }
+
+        return table;
+    }
+
+    inline constexpr type_table<type_kind> joins = make_joins();
+
+    std::string_view to_string(type_kind type);
+
+    constexpr bool is_implictly_convertible(type_kind from, type_kind to)
+    {
+        return conversions[index(from)][index(to)];
+    }
+
+    constexpr bool is_numeric(type_kind type)
+    {
+        return lattice[index(type)].numeric;
+    }
+
+    constexpr bool is_special(type_kind type)
+    {
+        return lattice[index(type)].special;
+    }
+
+    constexpr type_kind cast_up(type_kind first, type_kind second)
+    {
+        return joins[index(first)][index(second)];
+    }
 }
 
-#endif
\ No newline at end of file
+#endif
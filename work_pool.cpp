@@ -0,0 +1,100 @@
+#include "work_pool.hpp"
+#include <thread>
+
+using std::size_t;
+using std::vector;
+using std::function;
+
+work_pool::work_pool(size_t thread_count): queues()
+{
+    if (thread_count == 0)
+    {
+        thread_count = std::thread::hardware_concurrency();
+    }
+
+    if (thread_count == 0)
+    {
+        thread_count = 1;
+    }
+
+    for (size_t i = 0; i < thread_count; i++)
+    {
+        queues.emplace_back(new worker_queue());
+    }
+}
+
+size_t work_pool::size() const
+{
+    return queues.size();
+}
+
+bool work_pool::take(size_t worker, size_t& task)
+{
+    worker_queue& queue = *queues[worker];
+    std::lock_guard<std::mutex> guard(queue.lock);
+
+    if (queue.tasks.empty())
+    {
+        return false;
+    }
+
+    task = queue.tasks.front();
+    queue.tasks.pop_front();
+    return true;
+}
+
+bool work_pool::steal(size_t worker, size_t& task)
+{
+    for (size_t i = 1; i < queues.size(); i++)
+    {
+        worker_queue& victim = *queues[(worker + i) % queues.size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+
+        if (victim.tasks.empty() == false)
+        {
+            task = victim.tasks.back();
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void work_pool::work(size_t worker, const function<void(size_t, size_t)>& task)
+{
+    size_t next;
+
+    // tasks are only added before the workers start, so once every deque is empty the work is done.
+    while (take(worker, next) || steal(worker, next))
+    {
+        task(worker, next);
+    }
+}
+
+void work_pool::run(const vector<size_t>& order, const function<void(size_t, size_t)>& task)
+{
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        queues[i % queues.size()]->tasks.push_back(order[i]);
+    }
+
+    size_t thread_count = order.size() < queues.size() ? order.size() : queues.size();
+    vector<std::thread> threads;
+
+    for (size_t worker = 1; worker < thread_count; worker++)
+    {
+        threads.emplace_back(&work_pool::work, this, worker, std::cref(task));
+    }
+
+    // the calling thread is worker 0.
+    if (thread_count > 0)
+    {
+        work(0, task);
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef _WORK_POOL_HPP_
+#define _WORK_POOL_HPP_
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <memory>
+#include <functional>
+#include <cstddef>
+
+// fixed number of worker threads, each with its own deque of tasks.
+// a worker runs tasks from the front of its deque, and once it is empty steals from the back of the others.
+class work_pool
+{
+    private:
+
+    struct worker_queue
+    {
+        std::mutex lock;
+        std::deque<std::size_t> tasks;
+    };
+
+    std::vector<std::unique_ptr<worker_queue>> queues;
+
+    bool take(std::size_t worker, std::size_t& task);
+
+    bool steal(std::size_t worker, std::size_t& task);
+
+    void work(std::size_t worker, const std::function<void(std::size_t, std::size_t)>& task);
+
+    public:
+
+    // a thread count of 0 sizes the pool to the machine.
+    work_pool(std::size_t thread_count = 0);
+
+    work_pool(const work_pool& other) = delete;
+    work_pool& operator=(const work_pool& other) = delete;
+
+    std::size_t size() const;
+
+    // calls task(worker, index) for every index in order, dealt round robin so that each worker starts on the earliest ones.
+    // worker is below size(), so callers may keep state per worker. returns once all calls have returned.
+    void run(const std::vector<std::size_t>& order, const std::function<void(std::size_t, std::size_t)>& task);
+};
+
+#endif